@@ -3,44 +3,170 @@
 #include "Mongoose_EdgeCut.hpp"
 #include "Mongoose_IO.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_MemoryProfiler.hpp"
+#include "Mongoose_OpCounters.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_PerfCounters.hpp"
+#include "Mongoose_Trace.hpp"
 #include "Mongoose_Version.hpp"
 
 #include <fstream>
 
 using namespace Mongoose;
 
+static bool hasExtension(const std::string &filename, const char *extension)
+{
+    size_t length = std::string(extension).size();
+    return (filename.size() > length
+            && filename.compare(filename.size() - length, length, extension)
+                   == 0);
+}
+
+// Print the statistics of each coarsening level as a JSON array
+static void printLevelStats(std::ostream &out, const EdgeCut *result)
+{
+    out << "[";
+    for (Int k = 0; k < result->num_levels; k++)
+    {
+        const EdgeCut_LevelStats &stats = result->level_stats[k];
+        out << ((k > 0) ? "," : "") << std::endl
+            << "    { \"Level\": " << k << ", \"n\": " << stats.n
+            << ", \"nz\": " << stats.nz
+            << ", \"Contraction\": " << stats.contraction
+            << ", \"Matches\": [" << stats.match_count[0] << ", "
+            << stats.match_count[1] << ", " << stats.match_count[2] << ", "
+            << stats.match_count[3] << "]," << std::endl
+            << "      \"CutCostBefore\": " << stats.cut_cost_before
+            << ", \"ImbalanceBefore\": " << stats.imbalance_before
+            << ", \"CutCostAfter\": " << stats.cut_cost_after
+            << ", \"ImbalanceAfter\": " << stats.imbalance_after << ","
+            << std::endl
+            << "      \"FMPasses\": " << stats.fm_passes
+            << ", \"FMMoves\": " << stats.fm_moves
+            << ", \"FMRollbacks\": " << stats.fm_rollbacks
+            << ", \"QPIterations\": " << stats.qp_iterations
+            << ", \"QPError\": " << stats.qp_error << "," << std::endl
+            << "      \"Timing\": { \"Matching\": " << stats.matching_time
+            << ", \"Coarsening\": " << stats.coarsening_time
+            << ", \"GuessCut\": " << stats.guess_cut_time
+            << ", \"Refinement\": " << stats.refinement_time
+            << ", \"Waterdance\": " << stats.waterdance_time
+            << ", \"FM\": " << stats.fm_time
+            << ", \"QP\": " << stats.qp_time << " }";
+        if (MemoryProfiler::isProfiling())
+        {
+            out << "," << std::endl
+                << "      \"Allocations\": " << stats.allocations
+                << ", \"AllocatedBytes\": " << stats.allocated_bytes
+                << ", \"PeakBytes\": " << stats.peak_bytes;
+        }
+        out << " }";
+    }
+    out << ((result->num_levels > 0) ? "\n  " : "") << "]";
+}
+
 int main(int argn, const char **argv)
 {
     SuiteSparse_start();
 
-    clock_t t;
+    int64_t t;
     
     // Set Logger to report only Error messages
     Logger::setDebugLevel(Error);
 
-    if (argn < 2 || argn > 3)
+    // Read in the input file name, an optional output file name, an
+    // optional --format=text|binary|permutation for the partition, an
+    // optional --trace=<file> for a Chrome trace of the run, an optional
+    // --counters to add hardware performance counts to the JSON output and
+    // an optional --stats to add the statistics of each coarsening level
+    // and the operation counts, an optional --memory to add the
+    // allocations and peak memory use of each phase, and an optional
+    // --threads=<n> to use at most n threads (1 runs serially)
+    std::string inputFile;
+    std::string traceFile;
+    bool counters = false;
+    bool stats    = false;
+    bool memory   = false;
+    std::string outputFile = "mongoose_out.txt";
+    PartitionFormat format = PartitionFormat_Text;
+    int positional         = 0;
+    bool validArguments    = true;
+    for (int k = 1; k < argn; k++)
     {
-        // Wrong number of arguments - return error
-        LogError("Usage: mongoose <MM-input-file.mtx> [output-file]");
-        SuiteSparse_finish();
-        return EXIT_FAILURE;
+        std::string argument = std::string(argv[k]);
+        if (argument.compare(0, 9, "--format=") == 0)
+        {
+            std::string name = argument.substr(9);
+            if (name == "text")
+                format = PartitionFormat_Text;
+            else if (name == "binary")
+                format = PartitionFormat_Binary;
+            else if (name == "permutation")
+                format = PartitionFormat_Permutation;
+            else
+                validArguments = false;
+        }
+        else if (argument == "--counters")
+        {
+            counters = true;
+        }
+        else if (argument == "--stats")
+        {
+            stats = true;
+        }
+        else if (argument == "--memory")
+        {
+            memory = true;
+        }
+        else if (argument.compare(0, 10, "--threads=") == 0)
+        {
+            long numThreads = atol(argument.substr(10).c_str());
+            if (numThreads < 1)
+                validArguments = false;
+            else
+                threadLimit() = static_cast<size_t>(numThreads);
+        }
+        else if (argument.compare(0, 8, "--trace=") == 0)
+        {
+            traceFile = argument.substr(8);
+            if (traceFile.empty())
+                validArguments = false;
+        }
+        else if (positional == 0)
+        {
+            inputFile = argument;
+            positional++;
+        }
+        else if (positional == 1)
+        {
+            outputFile = argument;
+            positional++;
+        }
+        else
+        {
+            validArguments = false;
+        }
     }
 
-    // Read in input file name
-    std::string inputFile = std::string(argv[1]);
-
-    std::string outputFile;
-    if (argn == 3)
+    if (positional == 0 || !validArguments)
     {
-        outputFile = std::string(argv[2]);
-    }
-    else
-    {
-        outputFile = "mongoose_out.txt";
+        // Wrong arguments - return error
+        LogError("Usage: mongoose <MM-input-file.mtx|binary-file.mgb|"
+                 "METIS-file.graph|edge-list.bel> [output-file] "
+                 "[--format=text|binary|permutation] [--trace=trace.json] "
+                 "[--counters] [--stats] [--memory] [--threads=n]");
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
     }
 
     // Turn timing information on
     Logger::setTimingFlag(true);
+    Trace::setTracingFlag(!traceFile.empty());
+    if (counters && !PerfCounters::setCountingFlag(true))
+    {
+        std::cout << "Hardware performance counters are unavailable\n";
+    }
+    MemoryProfiler::setProfilingFlag(memory);
 
     EdgeCut_Options *options = EdgeCut_Options::create();
     if (!options)
@@ -49,8 +175,31 @@ int main(int argn, const char **argv)
         LogError("Error creating Options struct");
         return EXIT_FAILURE;
     }
+    options->collect_stats = stats;
 
-    Graph *graph = read_graph(inputFile);
+    // Pick the reader from the file extension: .mgb files hold an already
+    // sanitized graph in the Mongoose binary format, .graph, .metis and
+    // .chaco files are METIS/Chaco graphs, and .bel files are binary edge
+    // lists with native integer indices and double weights.
+    Graph *graph;
+    if (hasExtension(inputFile, ".mgb"))
+    {
+        graph = read_graph_binary(inputFile);
+    }
+    else if (hasExtension(inputFile, ".graph")
+             || hasExtension(inputFile, ".metis")
+             || hasExtension(inputFile, ".chaco"))
+    {
+        graph = read_graph_metis(inputFile);
+    }
+    else if (hasExtension(inputFile, ".bel"))
+    {
+        graph = read_graph_edgelist(inputFile);
+    }
+    else
+    {
+        graph = read_graph(inputFile);
+    }
 
     if (!graph)
     {
@@ -72,9 +221,9 @@ int main(int argn, const char **argv)
     std::cout << "********************************************************************************" << std::endl;
 
     // An edge separator should be computed with default options
-    t = clock();
+    t = Trace::now();
     EdgeCut *result = edge_cut(graph, options);
-    t = clock() - t;
+    t = Trace::now() - t;
 
     if (!result)
     {
@@ -87,7 +236,7 @@ int main(int argn, const char **argv)
     }
     else
     {
-        double test_time = ((double) t)/CLOCKS_PER_SEC;
+        double test_time = ((double) t) / 1e9;
         std::cout << "Total Edge Separator Time: " << test_time << "s\n";
         Logger::printTimingInfo();
         std::cout << "Cut Properties:\n";
@@ -95,11 +244,15 @@ int main(int argn, const char **argv)
         std::cout << " Cut Cost:       " << result->cut_cost << "\n";
         std::cout << " Imbalance:      " << result->imbalance << "\n";
 
-        // Write results to file
+        // Write results to file.  With the text format, the partition
+        // follows the information block in the output file; otherwise the
+        // information block goes to a .json file next to it.
         if (!outputFile.empty())
         {
             LogTest("Writing results to file: " << outputFile);
-            std::ofstream ofs (outputFile.c_str(), std::ofstream::out);
+            bool isText = (format == PartitionFormat_Text);
+            std::string infoFile = (isText) ? outputFile : outputFile + ".json";
+            std::ofstream ofs (infoFile.c_str(), std::ofstream::out);
             ofs << "{" << std::endl;
             ofs << "  \"InputFile\": \"" << inputFile << "\"," << std::endl;
             ofs << "  \"Timing\": {" << std::endl;
@@ -111,22 +264,59 @@ int main(int argn, const char **argv)
             ofs << "    \"QP\": " << Logger::getTime(QPTiming) << "," << std::endl;
             ofs << "    \"IO\": " << Logger::getTime(IOTiming) << std::endl;
             ofs << "  }," << std::endl;
+            if (counters)
+            {
+                ofs << "  \"Counters\": ";
+                PerfCounters::printJSON(ofs, "  ");
+                ofs << "," << std::endl;
+            }
+            if (stats)
+            {
+                ofs << "  \"Levels\": ";
+                printLevelStats(ofs, result);
+                ofs << "," << std::endl;
+                ofs << "  \"Operations\": ";
+                OpCounters::printJSON(ofs, "  ");
+                ofs << "," << std::endl;
+            }
+            if (memory)
+            {
+                ofs << "  \"Memory\": ";
+                MemoryProfiler::printJSON(ofs, "  ");
+                ofs << "," << std::endl;
+            }
             ofs << "  \"CutSize\": " << result->cut_size << "," << std::endl;
             ofs << "  \"CutCost\": " << result->cut_cost << "," << std::endl;
             ofs << "  \"Imbalance\": " << result->imbalance << std::endl;
             ofs << "}" << std::endl;
+            if (isText)
+                ofs << std::endl;
+            ofs.close();
 
-            ofs << std::endl;
-            for (Int i = 0; i < graph->n; i++)
+            bool written;
+            if (isText)
             {
-                ofs << i << " " << result->partition[i] << std::endl;
+                FILE *file = fopen(outputFile.c_str(), "a");
+                written    = file && write_partition(result, file, format)
+                          && fputc('\n', file) != EOF;
+                written = (file && fclose(file) == 0) && written;
+            }
+            else
+            {
+                written = write_partition(result, outputFile, format);
+            }
+            if (!written)
+            {
+                LogError("Error writing partition to file");
             }
-            ofs << std::endl;
-
-            ofs.close();
         }
     }
 
+    if (!traceFile.empty() && !Trace::writeChromeTrace(traceFile))
+    {
+        LogError("Error writing trace to file");
+    }
+
     options->~EdgeCut_Options();
     graph->~Graph();
     result->~EdgeCut();
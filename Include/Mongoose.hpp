@@ -49,10 +49,34 @@ enum InitialEdgeCutType
     InitialEdgeCut_NaturalOrder
 };
 
+enum ComponentStrategy
+{
+    Components_Together,
+    Components_Largest,
+    Components_BinPack
+};
+
+enum CycleType
+{
+    Cycle_V,
+    Cycle_F
+};
+
+enum PartitionFormat
+{
+    PartitionFormat_Text,
+    PartitionFormat_Binary,
+    PartitionFormat_Permutation
+};
+
 struct EdgeCut_Options
 {
     Int random_seed;
 
+    /** Connected Component Options ******************************************/
+    ComponentStrategy component_strategy; /* How to handle a graph with
+                                             several components      */
+
     /** Coarsening Options ***************************************************/
     Int coarsen_limit;
     MatchingStrategy matching_strategy;
@@ -62,9 +86,30 @@ struct EdgeCut_Options
     /** Guess Partitioning Options *******************************************/
     InitialEdgeCutType initial_cut_type; /* The guess cut type to use */
 
+    /** Multilevel Cycle Options *********************************************/
+    Int num_cycles;               /* Max # of multilevel cycles, 1 = one pass */
+    CycleType cycle_type;         /* Shape of the cycles after the first      */
+    double cycle_min_improvement; /* Relative improvement below which the
+                                     cycles stop                            */
+    double cycle_time_budget;     /* Seconds for the cycles after the first,
+                                     0 = none                               */
+
+    /** Evolution Options ****************************************************/
+    bool use_evolution;             /* Evolve a population of partitions */
+    Int evolution_population;       /* # of partitions in the population */
+    Int evolution_generations;      /* Max # of generations              */
+    double evolution_mutation_rate; /* Fraction of offspring made by
+                                       mutation rather than combination */
+    double evolution_time_budget;   /* Seconds of evolution, 0 = none    */
+
     /** Waterdance Options ***************************************************/
     Int num_dances; /* The number of interplays between FM and QP
                       at any one coarsening level. */
+    bool use_adaptive_waterdance;  /* Skip refiners that stop paying off */
+    double waterdance_min_payoff;  /* Relative improvement per second below
+                                      which a refiner is skipped         */
+    Int waterdance_max_dances;     /* Max # of dances at any one level   */
+    double waterdance_time_budget; /* Total waterdance seconds, 0 = none */
 
     /**** Fidducia-Mattheyes Options *****************************************/
     bool use_FM;              /* Flag governing the use of FM             */
@@ -76,6 +121,8 @@ struct EdgeCut_Options
     bool use_QP_gradproj;         /* Flag governing the use of gradproj       */
     double gradproj_tolerance;   /* Convergence tol for projected gradient   */
     Int gradproj_iteration_limit; /* Max # of iterations for gradproj         */
+    bool use_QP_single_precision; /* Solve the QP in float, polish in double  */
+    bool use_QP_prolongation;     /* Warm start QP from coarse level solution */
 
     /** Final Partition Target Metrics ***************************************/
     double target_split;        /* The desired split ratio (default 50/50)  */
@@ -83,6 +130,9 @@ struct EdgeCut_Options
     /* Cuts within this tolerance are treated   */
     /* equally.                                 */
 
+    /** Diagnostics **********************************************************/
+    bool collect_stats; /* Return statistics of each level in the EdgeCut */
+
     /* Constructor & Destructor */
     static EdgeCut_Options *create();
     ~EdgeCut_Options();
@@ -113,6 +163,12 @@ private:
     bool shallow_i;
     bool shallow_x;
     bool shallow_w;
+
+    /** Memory mapped file backing the shallow arrays, if any */
+    void *mapping;
+    size_t mappingSize;
+
+    friend Graph *read_graph_binary(const char *filename);
 };
 
 /**
@@ -120,9 +176,11 @@ private:
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed. A gzip-compressed file is decompressed while
+ * it is being parsed, if Mongoose was built with zlib. All connected
+ * components are kept; use largest_component, or the component_strategy
+ * option of edge_cut, to handle a graph with more than one.
  *
  * @param filename the filename or path to the Matrix Market File.
  */
@@ -133,18 +191,304 @@ Graph *read_graph(const std::string &filename);
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed. A gzip-compressed file is decompressed while
+ * it is being parsed, if Mongoose was built with zlib. All connected
+ * components are kept; use largest_component, or the component_strategy
+ * option of edge_cut, to handle a graph with more than one.
  *
  * @param filename the filename or path to the Matrix Market File.
  */
 Graph *read_graph(const char *filename);
 
+/**
+ * Generate a Graph from a METIS or Chaco graph file.
+ *
+ * The header line gives the number of vertices and edges and, optionally, a
+ * format code saying whether edge weights, vertex weights and vertex sizes
+ * follow. Each following line (other than % comments) lists the 1-based
+ * neighbors of one vertex. Vertex sizes are ignored, and of several vertex
+ * weights only the first is kept. The file is parsed on multiple threads.
+ *
+ * @param filename the filename or path to the graph file.
+ */
+Graph *read_graph_metis(const std::string &filename);
+
+/**
+ * Generate a Graph from a METIS or Chaco graph file.
+ *
+ * The header line gives the number of vertices and edges and, optionally, a
+ * format code saying whether edge weights, vertex weights and vertex sizes
+ * follow. Each following line (other than % comments) lists the 1-based
+ * neighbors of one vertex. Vertex sizes are ignored, and of several vertex
+ * weights only the first is kept. The file is parsed on multiple threads.
+ *
+ * @param filename the filename or path to the graph file.
+ */
+Graph *read_graph_metis(const char *filename);
+
+/**
+ * Generate a Graph from a binary edge list.
+ *
+ * The file is a sequence of records in native byte order, each holding two
+ * 0-based vertex indices of indexWidth bytes and, if weighted, a double edge
+ * weight. Each edge should be listed once; duplicates are summed and self
+ * edges are removed. The number of vertices is one more than the largest
+ * index.
+ *
+ * @param filename the filename or path to the edge list file.
+ * @param indexWidth the size of each vertex index in bytes, 4 or 8.
+ * @param weighted true if each record ends with an edge weight.
+ */
+Graph *read_graph_edgelist(const std::string &filename,
+                           size_t indexWidth = sizeof(Int),
+                           bool weighted     = true);
+
+/**
+ * Generate a Graph from a binary edge list.
+ *
+ * The file is a sequence of records in native byte order, each holding two
+ * 0-based vertex indices of indexWidth bytes and, if weighted, a double edge
+ * weight. Each edge should be listed once; duplicates are summed and self
+ * edges are removed. The number of vertices is one more than the largest
+ * index.
+ *
+ * @param filename the filename or path to the edge list file.
+ * @param indexWidth the size of each vertex index in bytes, 4 or 8.
+ * @param weighted true if each record ends with an edge weight.
+ */
+Graph *read_graph_edgelist(const char *filename,
+                           size_t indexWidth = sizeof(Int),
+                           bool weighted     = true);
+
+/**
+ * Generate a Graph from a Mongoose binary graph file.
+ *
+ * The file holds an already sanitized graph, as written by write_graph_binary,
+ * so no parsing or sanitizing is needed. Where possible the file is memory
+ * mapped and the Graph arrays point directly into the mapping, which is
+ * released when the Graph is destroyed. The arrays are mapped copy-on-write,
+ * so the file itself is never modified.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const std::string &filename);
+
+/**
+ * Generate a Graph from a Mongoose binary graph file.
+ *
+ * The file holds an already sanitized graph, as written by write_graph_binary,
+ * so no parsing or sanitizing is needed. Where possible the file is memory
+ * mapped and the Graph arrays point directly into the mapping, which is
+ * released when the Graph is destroyed. The arrays are mapped copy-on-write,
+ * so the file itself is never modified.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const char *filename);
+
+/**
+ * Write a Graph to a Mongoose binary graph file.
+ *
+ * The file starts with a 64 byte header (magic, format version, index width,
+ * byte order, weight flags, n and nz) followed by p, i, and the optional edge
+ * weights x and vertex weights w, each starting on an 8 byte boundary.
+ *
+ * @param graph the (sanitized) graph to write.
+ * @param filename the filename or path of the file to create.
+ * @param compactIndices store p and i as 32-bit integers if they fit, which
+ *   halves their size but means they are widened on load rather than mapped.
+ * @return true if the file was written.
+ */
+bool write_graph_binary(const Graph *graph, const std::string &filename,
+                        bool compactIndices = false);
+
+/**
+ * Write a Graph to a Mongoose binary graph file.
+ *
+ * The file starts with a 64 byte header (magic, format version, index width,
+ * byte order, weight flags, n and nz) followed by p, i, and the optional edge
+ * weights x and vertex weights w, each starting on an 8 byte boundary.
+ *
+ * @param graph the (sanitized) graph to write.
+ * @param filename the filename or path of the file to create.
+ * @param compactIndices store p and i as 32-bit integers if they fit, which
+ *   halves their size but means they are widened on load rather than mapped.
+ * @return true if the file was written.
+ */
+bool write_graph_binary(const Graph *graph, const char *filename,
+                        bool compactIndices = false);
+
+/**
+ * Find the connected components of a Graph.
+ *
+ * Components are numbered in order of their lowest numbered vertex. The edges
+ * are processed concurrently with a lock-free union-find when the graph is
+ * large enough to benefit.
+ *
+ * @param graph the graph, which must have a symmetric pattern.
+ * @param component array of size graph->n that receives the component of
+ *   each vertex.
+ * @return the number of components, or -1 if out of memory.
+ */
+Int connected_components(const Graph *graph, Int *component);
+
+/**
+ * Extract the largest connected component of a Graph.
+ *
+ * The largest component is the one with the greatest total vertex weight,
+ * with ties going to the component with the lowest numbered vertex. Vertices
+ * keep their relative order.
+ *
+ * @param graph the graph, which must have a symmetric pattern.
+ * @param vertex_map array of size graph->n (or NULL). On return, entry k of
+ *   vertex_map holds the vertex of graph that became vertex k of the result.
+ * @return a new Graph holding the largest component, or NULL if out of
+ *   memory.
+ */
+Graph *largest_component(const Graph *graph, Int *vertex_map);
+
+/**
+ * Generate a grid graph.
+ *
+ * Each vertex of an nx-by-ny-by-nz grid is joined to the vertices next to it
+ * along each axis, as in a 5 point (nz = 1) or 7 point finite difference
+ * stencil. Vertices are numbered along x first, then y, then z.
+ *
+ * @return the graph, or NULL if a dimension is not positive or memory runs
+ *   out.
+ */
+Graph *generate_grid(Int nx, Int ny, Int nz = 1);
+
+/**
+ * Generate the graph of a finite element mesh.
+ *
+ * The mesh has nx-by-ny-by-nz vertices, and each vertex is joined to every
+ * other vertex of the bilinear (nz = 1) or trilinear elements it belongs to,
+ * as in a 9 point or 27 point stencil.
+ *
+ * @return the graph, or NULL if a dimension is not positive or memory runs
+ *   out.
+ */
+Graph *generate_mesh(Int nx, Int ny, Int nz = 1);
+
+/**
+ * Generate a random geometric graph.
+ *
+ * n points are placed uniformly at random in the unit square or cube, and
+ * every two points closer than a fixed radius are joined. The radius gives
+ * the requested average degree away from the boundary. The graph depends
+ * only on the arguments, not on the number of threads used to build it.
+ *
+ * @param dimension 2 or 3.
+ * @param seed the seed of the random point coordinates.
+ * @return the graph, or NULL if an argument is invalid or memory runs out.
+ */
+Graph *generate_geometric(Int n, double average_degree, Int dimension = 2,
+                          Int seed = 1);
+
+/**
+ * Generate an R-MAT (recursive Kronecker) power-law graph.
+ *
+ * The graph has 2^scale vertices. Each of its edge_factor * 2^scale edges is
+ * placed by recursively choosing a quadrant of the adjacency matrix with
+ * probabilities a, b, c and 1 - a - b - c. Duplicate and self edges are
+ * dropped, and the vertices are randomly renumbered. The defaults are those
+ * of the Graph500 benchmark. The graph depends only on the arguments.
+ *
+ * @return the graph, or NULL if an argument is invalid or memory runs out.
+ */
+Graph *generate_rmat(Int scale, Int edge_factor = 16, double a = 0.57,
+                     double b = 0.19, double c = 0.19, Int seed = 1);
+
+/**
+ * Generate an Erdos-Renyi random graph.
+ *
+ * The graph has n vertices and n * average_degree / 2 edges, whose endpoints
+ * are chosen uniformly at random. The few duplicate and self edges are
+ * dropped. The graph depends only on the arguments.
+ *
+ * @return the graph, or NULL if an argument is invalid or memory runs out.
+ */
+Graph *generate_erdos_renyi(Int n, double average_degree, Int seed = 1);
+
+/**
+ * Generate a graph from a short specification.
+ *
+ * The specification is family:size, optionally followed by :seed. The
+ * families are grid2d and grid3d (size k gives a k-by-k or k-by-k-by-k
+ * grid), mesh2d and mesh3d (likewise), geo2d and geo3d (a random geometric
+ * graph with size vertices and average degree 10), rmat (2^size vertices
+ * and edge factor 16) and er (an Erdos-Renyi graph with size vertices and
+ * average degree 10).
+ *
+ * @param spec the specification, such as grid3d:100 or rmat:20:7.
+ * @return the graph, or NULL if the specification is invalid or memory runs
+ *   out.
+ */
+Graph *generate_graph(const std::string &spec);
+
+/**
+ * Generate a graph from a short specification.
+ *
+ * The specification is family:size, optionally followed by :seed. The
+ * families are grid2d and grid3d (size k gives a k-by-k or k-by-k-by-k
+ * grid), mesh2d and mesh3d (likewise), geo2d and geo3d (a random geometric
+ * graph with size vertices and average degree 10), rmat (2^size vertices
+ * and edge factor 16) and er (an Erdos-Renyi graph with size vertices and
+ * average degree 10).
+ *
+ * @param spec the specification, such as grid3d:100 or rmat:20:7.
+ * @return the graph, or NULL if the specification is invalid or memory runs
+ *   out.
+ */
+Graph *generate_graph(const char *spec);
+
+/* Statistics of one coarsening level, gathered by edge_cut if
+ * options->collect_stats is set. Times are wall-clock seconds. */
+struct EdgeCut_LevelStats
+{
+    Int n;              /** # vertices                            */
+    Int nz;             /** # edges                               */
+    double contraction; /** # vertices of the next coarser level
+                            over n, or 1 on the coarsest level    */
+    Int match_count[4]; /** # vertices of each MatchType: orphan,
+                            standard, brotherly and community     */
+
+    /** Cut Cost Metrics *****************************************************/
+    double cut_cost_before;  /** Cut cost and imbalance before and     */
+    double imbalance_before; /** after the (last) waterdance           */
+    double cut_cost_after;
+    double imbalance_after;
+
+    /** Refinement Work ******************************************************/
+    Int fm_passes;       /** # of Fiduccia-Mattheyses passes       */
+    Int fm_moves;        /** # of moves committed                  */
+    Int fm_rollbacks;    /** # of moves rolled back                */
+    Int qp_iterations;   /** # of gradient projection iterations   */
+    double qp_error;     /** err of the last gradient projection   */
+
+    /** Time per Phase *******************************************************/
+    double matching_time;
+    double coarsening_time;
+    double guess_cut_time;  /** Coarsest level only                  */
+    double refinement_time; /** Projecting the coarser cut onto this */
+    double waterdance_time; /** Includes fm_time and qp_time         */
+    double fm_time;
+    double qp_time;
+
+    /** Memory, if MemoryProfiler is on **************************************/
+    Int allocations;     /** # of SuiteSparse allocations          */
+    Int allocated_bytes; /** Total size of those allocations       */
+    Int peak_bytes;      /** Peak bytes in use during this level   */
+};
+
 struct EdgeCut
 {
     bool *partition;     /** T/F denoting partition side     */
     Int n;               /** # vertices                      */
+    Int *vertex_map;     /** Original vertex of each vertex,
+                             or NULL if all were partitioned */
 
     /** Cut Cost Metrics *****************************************************/
     double cut_cost;    /** Sum of edge weights in cut set    */
@@ -155,6 +499,11 @@ struct EdgeCut
                             is imbalanced, and this is
                             computed as (0.5 - W0/W).         */
 
+    /** Statistics (NULL unless options->collect_stats) **********************/
+    Int num_levels;                  /** # coarsening levels, 0 if none */
+    EdgeCut_LevelStats *level_stats; /** Statistics of each level, the
+                                         finest (the input) first      */
+
     // desctructor (no constructor)
     ~EdgeCut();
 };
@@ -162,6 +511,114 @@ struct EdgeCut
 EdgeCut *edge_cut(const Graph *);
 EdgeCut *edge_cut(const Graph *, const EdgeCut_Options *);
 
+/**
+ * Write the partition of an edge cut to a file.
+ *
+ * Text output has one "vertex part" line per vertex. Binary output is a
+ * 32 byte header followed by the partition packed eight vertices to a byte,
+ * bit k % 8 of byte k / 8 holding vertex k. Permutation output lists the
+ * vertices in part 0 and then those in part 1, one per line, which is the
+ * order in which to permute a matrix so that the parts form its diagonal
+ * blocks. Vertices are numbered from 0. If the cut covers only part of a
+ * graph (cut->vertex_map is not NULL), text and permutation output give the
+ * original vertex numbers, and binary output appends them as 64-bit integers.
+ *
+ * @param cut the edge cut to write.
+ * @param filename the filename or path of the file to create.
+ * @param format PartitionFormat_Text, PartitionFormat_Binary or
+ *   PartitionFormat_Permutation.
+ * @return true if the file was written.
+ */
+bool write_partition(const EdgeCut *cut, const std::string &filename,
+                     PartitionFormat format = PartitionFormat_Text);
+
+/**
+ * Write the partition of an edge cut to a file.
+ *
+ * Text output has one "vertex part" line per vertex. Binary output is a
+ * 32 byte header followed by the partition packed eight vertices to a byte,
+ * bit k % 8 of byte k / 8 holding vertex k. Permutation output lists the
+ * vertices in part 0 and then those in part 1, one per line, which is the
+ * order in which to permute a matrix so that the parts form its diagonal
+ * blocks. Vertices are numbered from 0. If the cut covers only part of a
+ * graph (cut->vertex_map is not NULL), text and permutation output give the
+ * original vertex numbers, and binary output appends them as 64-bit integers.
+ *
+ * @param cut the edge cut to write.
+ * @param filename the filename or path of the file to create.
+ * @param format PartitionFormat_Text, PartitionFormat_Binary or
+ *   PartitionFormat_Permutation.
+ * @return true if the file was written.
+ */
+bool write_partition(const EdgeCut *cut, const char *filename,
+                     PartitionFormat format = PartitionFormat_Text);
+
+/**
+ * Coarsen a Graph as edge_cut would and save every level to a file.
+ *
+ * Each level's graph (p, i, x and w) is written along with the matching that
+ * links it to the next coarser level (matching, matchmap, invmatchmap and
+ * matchtype), each array starting on an 8 byte boundary after a header and a
+ * table of levels. The options used are the matching and coarsening options
+ * and the random seed; options->component_strategy is ignored.
+ *
+ * @param graph the (sanitized) graph to coarsen.
+ * @param options the options to coarsen with.
+ * @param filename the filename or path of the file to create.
+ * @return true if the file was written.
+ */
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const std::string &filename);
+
+/**
+ * Coarsen a Graph as edge_cut would and save every level to a file.
+ *
+ * Each level's graph (p, i, x and w) is written along with the matching that
+ * links it to the next coarser level (matching, matchmap, invmatchmap and
+ * matchtype), each array starting on an 8 byte boundary after a header and a
+ * table of levels. The options used are the matching and coarsening options
+ * and the random seed; options->component_strategy is ignored.
+ *
+ * @param graph the (sanitized) graph to coarsen.
+ * @param options the options to coarsen with.
+ * @param filename the filename or path of the file to create.
+ * @return true if the file was written.
+ */
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const char *filename);
+
+/**
+ * Partition the graph of a saved coarsening hierarchy.
+ *
+ * The hierarchy written by write_hierarchy is memory mapped where possible,
+ * and edge_cut continues from the guess cut on its coarsest level, skipping
+ * matching and coarsening. The matching and coarsening options are therefore
+ * ignored. With a matching strategy that does not draw random numbers (all
+ * but Random) and the same options, the result is the same as edge_cut's.
+ *
+ * @param filename the filename or path of the hierarchy file.
+ * @param options the options to partition with.
+ * @return the edge cut, or NULL if the file cannot be read or memory runs out.
+ */
+EdgeCut *edge_cut_hierarchy(const std::string &filename,
+                            const EdgeCut_Options *options);
+
+/**
+ * Partition the graph of a saved coarsening hierarchy.
+ *
+ * The hierarchy written by write_hierarchy is memory mapped where possible,
+ * and edge_cut continues from the guess cut on its coarsest level, skipping
+ * matching and coarsening. The matching and coarsening options are therefore
+ * ignored. With a matching strategy that does not draw random numbers (all
+ * but Random) and the same options, the result is the same as edge_cut's.
+ *
+ * @param filename the filename or path of the hierarchy file.
+ * @param options the options to partition with.
+ * @return the edge cut, or NULL if the file cannot be read or memory runs out.
+ */
+EdgeCut *edge_cut_hierarchy(const char *filename,
+                            const EdgeCut_Options *options);
+
 /* Version information */
 int major_version();
 int minor_version();
@@ -0,0 +1,76 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Components.hpp ====================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Connected components of a graph
+ *
+ * Components are found with a lock-free union-find, so that the edges can be
+ * processed by several threads at once. A graph with more than one component
+ * can then be reduced to its largest component, or have each component
+ * partitioned on its own with the results packed into one edge cut.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_COMPONENTS_HPP
+#define MONGOOSE_COMPONENTS_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_Graph.hpp"
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+/**
+ * Find the connected components of a Graph.
+ *
+ * @param graph the graph, which must have a symmetric pattern.
+ * @param component array of size graph->n that receives the component of
+ *   each vertex, numbered in order of their lowest numbered vertex.
+ * @return the number of components, or -1 if out of memory.
+ */
+Int connected_components(const Graph *graph, Int *component);
+
+/**
+ * Extract the largest connected component of a Graph.
+ *
+ * @param graph the graph, which must have a symmetric pattern.
+ * @param vertex_map array of size graph->n (or NULL) that receives the
+ *   original vertex of each vertex of the result.
+ * @return a new Graph holding the largest component, or NULL if out of
+ *   memory.
+ */
+Graph *largest_component(const Graph *graph, Int *vertex_map);
+
+/**
+ * Extract the vertices of one component, in their original order.
+ *
+ * @param graph the graph.
+ * @param component the component of each vertex.
+ * @param label the component to extract.
+ * @param vertex_map array of at least the component's size (or NULL) that
+ *   receives the original vertex of each vertex of the result.
+ * @return a new Graph holding the component, or NULL if out of memory.
+ */
+Graph *extractComponent(const Graph *graph, const Int *component, Int label,
+                        Int *vertex_map);
+
+/**
+ * Compute an edge cut according to options->component_strategy, for any
+ * strategy other than Components_Together.
+ */
+EdgeCut *edgeCutByComponents(const Graph *graph,
+                             const EdgeCut_Options *options);
+
+} // end namespace Mongoose
+
+#endif
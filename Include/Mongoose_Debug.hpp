@@ -89,11 +89,13 @@ void print(cs *G);
 
 void print(EdgeCutProblem *G);
 
-void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool check_b,
-                Int nFreeSet, double b);
+template <typename Float>
+void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDeltaT<Float> *QP,
+                bool check_b, Int nFreeSet, double b);
 
+template <typename Float>
 void FreeSet_dump(const char *where, Int n, Int *FreeSet_list, Int nFreeSet,
-                  Int *FreeSet_status, Int verbose, double *x);
+                  Int *FreeSet_status, Int verbose, Float *x);
 
 } // end namespace Mongoose
 
@@ -24,6 +24,8 @@ struct EdgeCut
 {
     bool *partition;     /** T/F denoting partition side     */
     Int n;               /** # vertices                      */
+    Int *vertex_map;     /** Original vertex of each vertex,
+                             or NULL if all were partitioned */
 
     /** Cut Cost Metrics *****************************************************/
     double cut_cost;    /** Sum of edge weights in cut set    */
@@ -34,6 +36,11 @@ struct EdgeCut
                             is imbalanced, and this is
                             computed as (0.5 - W0/W).         */
 
+    /** Statistics (NULL unless options->collect_stats) **********************/
+    Int num_levels;                  /** # coarsening levels, 0 if none */
+    EdgeCut_LevelStats *level_stats; /** Statistics of each level, the
+                                         finest (the input) first      */
+
     // desctructor (no constructor)
     ~EdgeCut();
 };
@@ -42,6 +49,26 @@ EdgeCut *edge_cut(const Graph *);
 EdgeCut *edge_cut(const Graph *, const EdgeCut_Options *);
 EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options);
 
+/* The two halves of edge_cut. coarsenHierarchy matches and coarsens an
+ * initialized problem until it is smaller than options->coarsen_limit and
+ * returns the coarsest level, or NULL if it runs out of memory.
+ * refineHierarchy computes a guess cut on the coarsest level and refines it
+ * back up to the finest one, freeing each coarse level on the way, then runs
+ * the further cycles asked for by options->num_cycles. */
+EdgeCutProblem *coarsenHierarchy(EdgeCutProblem *problem,
+                                 const EdgeCut_Options *options);
+EdgeCut *refineHierarchy(EdgeCutProblem *coarsest,
+                         const EdgeCut_Options *options);
+
+/* Run one more cycle from top, which must hold a partition with its boundary
+ * heaps loaded: recoarsen top while keeping the sides of its partition (and
+ * of top->crossSides, if any), and refine the inherited partition back up to
+ * top. An F-cycle also runs a V-cycle from every intermediate level on the
+ * way up. If the new partition is worse, or if memory runs out, top gets its
+ * old partition back. Returns false if out of memory. */
+bool multilevelCycle(EdgeCutProblem *top, const EdgeCut_Options *options,
+                     CycleType cycleType);
+
 } // end namespace Mongoose
 
 #endif
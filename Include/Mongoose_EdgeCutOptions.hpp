@@ -22,6 +22,10 @@ struct EdgeCut_Options
 {
     Int random_seed;
 
+    /** Connected Component Options ******************************************/
+    ComponentStrategy component_strategy; /* How to handle a graph with
+                                             several components      */
+
     /** Coarsening Options ***************************************************/
     Int coarsen_limit;
     MatchingStrategy matching_strategy;
@@ -31,9 +35,30 @@ struct EdgeCut_Options
     /** Guess Partitioning Options *******************************************/
     InitialEdgeCutType initial_cut_type; /* The guess cut type to use */
 
+    /** Multilevel Cycle Options *********************************************/
+    Int num_cycles;               /* Max # of multilevel cycles, 1 = one pass */
+    CycleType cycle_type;         /* Shape of the cycles after the first      */
+    double cycle_min_improvement; /* Relative improvement below which the
+                                     cycles stop                            */
+    double cycle_time_budget;     /* Seconds for the cycles after the first,
+                                     0 = none                               */
+
+    /** Evolution Options ****************************************************/
+    bool use_evolution;             /* Evolve a population of partitions */
+    Int evolution_population;       /* # of partitions in the population */
+    Int evolution_generations;      /* Max # of generations              */
+    double evolution_mutation_rate; /* Fraction of offspring made by
+                                       mutation rather than combination */
+    double evolution_time_budget;   /* Seconds of evolution, 0 = none    */
+
     /** Waterdance Options ***************************************************/
     Int num_dances; /* The number of interplays between FM and QP
                       at any one coarsening level. */
+    bool use_adaptive_waterdance;  /* Skip refiners that stop paying off */
+    double waterdance_min_payoff;  /* Relative improvement per second below
+                                      which a refiner is skipped         */
+    Int waterdance_max_dances;     /* Max # of dances at any one level   */
+    double waterdance_time_budget; /* Total waterdance seconds, 0 = none */
 
     /**** Fidducia-Mattheyes Options *****************************************/
     bool use_FM;              /* Flag governing the use of FM               */
@@ -45,6 +70,8 @@ struct EdgeCut_Options
     bool use_QP_gradproj;         /* Flag governing the use of gradproj       */
     double gradproj_tolerance;   /* Convergence tol for projected gradient   */
     Int gradproj_iteration_limit; /* Max # of iterations for gradproj         */
+    bool use_QP_single_precision; /* Solve the QP in float, polish in double  */
+    bool use_QP_prolongation;     /* Warm start QP from coarse level solution */
 
     /** Final Partition Target Metrics ***************************************/
     double target_split;        /* The desired split ratio (default 50/50)  */
@@ -52,6 +79,9 @@ struct EdgeCut_Options
                                /* Cuts within this tolerance are treated   */
                                /* equally.                                 */
 
+    /** Diagnostics **********************************************************/
+    bool collect_stats; /* Return statistics of each level in the EdgeCut */
+
     /* Constructor & Destructor */
     static EdgeCut_Options *create();
     ~EdgeCut_Options();
@@ -28,6 +28,45 @@
 namespace Mongoose
 {
 
+/* Statistics of one coarsening level, gathered by edge_cut if
+ * options->collect_stats is set. Times are wall-clock seconds. */
+struct EdgeCut_LevelStats
+{
+    Int n;              /** # vertices                            */
+    Int nz;             /** # edges                               */
+    double contraction; /** # vertices of the next coarser level
+                            over n, or 1 on the coarsest level    */
+    Int match_count[4]; /** # vertices of each MatchType: orphan,
+                            standard, brotherly and community     */
+
+    /** Cut Cost Metrics *****************************************************/
+    double cut_cost_before;  /** Cut cost and imbalance before and     */
+    double imbalance_before; /** after the (last) waterdance           */
+    double cut_cost_after;
+    double imbalance_after;
+
+    /** Refinement Work ******************************************************/
+    Int fm_passes;       /** # of Fiduccia-Mattheyses passes       */
+    Int fm_moves;        /** # of moves committed                  */
+    Int fm_rollbacks;    /** # of moves rolled back                */
+    Int qp_iterations;   /** # of gradient projection iterations   */
+    double qp_error;     /** err of the last gradient projection   */
+
+    /** Time per Phase *******************************************************/
+    double matching_time;
+    double coarsening_time;
+    double guess_cut_time;  /** Coarsest level only                  */
+    double refinement_time; /** Projecting the coarser cut onto this */
+    double waterdance_time; /** Includes fm_time and qp_time         */
+    double fm_time;
+    double qp_time;
+
+    /** Memory, if MemoryProfiler is on **************************************/
+    Int allocations;     /** # of SuiteSparse allocations          */
+    Int allocated_bytes; /** Total size of those allocations       */
+    Int peak_bytes;      /** Peak bytes in use during this level   */
+};
+
 class EdgeCutProblem
 {
 public:
@@ -52,6 +91,8 @@ public:
     Int *bhHeap[2];      /** Heap data structure organized by
                             boundaryGains descending         */
     Int bhSize[2];       /** Size of the boundary heap       */
+    double *qpSolution;  /** Continuous QP solution from the
+                             last QP pass, or NULL            */
 
     /** Cut Cost Metrics *****************************************************/
     double heuCost;   /** cutCost + balance penalty         */
@@ -76,6 +117,21 @@ public:
                            2: Brotherly
                            3: Community                   */
     Int singleton;
+    bool keepSides;   /** Only match vertices on the same side
+                          of the partition, which the coarse
+                          graph then inherits             */
+    bool *crossSides; /** If not NULL, a second partition
+                          whose sides are kept as well     */
+
+    /** Waterdance Data ******************************************************/
+    double fmPayoff;  /** Relative heuCost improvement per
+                          second of the last FM pass       */
+    double qpPayoff;  /** Same as fmPayoff, for QP          */
+    bool qpProbe;     /** Run QP regardless of qpPayoff    */
+    double danceTime; /** Seconds spent in the waterdance  */
+
+    /** Statistics ***********************************************************/
+    EdgeCut_LevelStats stats;
 
     /* Constructor & Destructor */
     static EdgeCutProblem *create(const Int _n, const Int _nz, Int *_p = NULL,
@@ -84,6 +140,7 @@ public:
     static EdgeCutProblem *create(EdgeCutProblem *_parent);
     ~EdgeCutProblem();
     void initialize(const EdgeCut_Options *options);
+    void clearMatching();
 
     /** Matching Functions ****************************************************/
     inline bool isMatched(Int vertex)
@@ -96,6 +153,12 @@ public:
         return (matching[vertex] - 1);
     }
 
+    inline bool canMatch(Int vertexA, Int vertexB)
+    {
+        return (!keepSides || partition[vertexA] == partition[vertexB])
+               && (!crossSides || crossSides[vertexA] == crossSides[vertexB]);
+    }
+
     inline void createMatch(Int vertexA, Int vertexB, MatchType matchType)
     {
         matching[vertexA]  = (vertexB) + 1;
@@ -0,0 +1,54 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Evolution.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Memetic edge cuts
+ *
+ * A population of partitions is evolved with the multilevel pipeline as its
+ * engine. The first generation is made of ordinary edge cuts from different
+ * random seeds. Each later generation makes one offspring per member, all in
+ * parallel: either a combination of two parents, made by a multilevel cycle
+ * that never matches vertices cut in either parent, or a mutant of one
+ * parent, made by flipping part of its boundary and repairing it with a
+ * multilevel cycle. An offspring then replaces the worst member if it is
+ * better and not already in the population. All random choices depend only
+ * on the seed, the generation and the offspring, so the result does not
+ * depend on the number of threads. The phases timed while making each
+ * member or offspring are added to the Logger times of the calling thread,
+ * so with several threads they can add up to more than the elapsed time.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_EVOLUTION_HPP
+#define MONGOOSE_EVOLUTION_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+/**
+ * Evolve a population of edge cuts of a problem for up to
+ * options->evolution_generations generations, or until
+ * options->evolution_time_budget is spent.
+ *
+ * @return the best edge cut found, without level statistics, or NULL if out
+ *   of memory.
+ */
+EdgeCut *evolveEdgeCut(EdgeCutProblem *problem,
+                       const EdgeCut_Options *options);
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,91 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Generators.hpp ====================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Synthetic graph generators
+ *
+ * Grids, finite element meshes, random geometric graphs, R-MAT power-law
+ * graphs and Erdos-Renyi graphs of any size, for benchmarks that cannot rely
+ * on downloaded matrices. Every random choice is a hash of the seed and of
+ * the index of the point or edge being drawn, so the graph depends only on
+ * its parameters and not on the number of threads that build it.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_GENERATORS_HPP
+#define MONGOOSE_GENERATORS_HPP
+
+#include "Mongoose_Graph.hpp"
+#include "Mongoose_Internal.hpp"
+
+#include <string>
+
+namespace Mongoose
+{
+
+/**
+ * Generate an nx-by-ny-by-nz grid, with each vertex joined to the vertices
+ * next to it along each axis (a 5 point stencil if nz is 1, otherwise 7).
+ */
+Graph *generate_grid(Int nx, Int ny, Int nz = 1);
+
+/**
+ * Generate the graph of a mesh of nx-by-ny-by-nz bilinear (nz = 1) or
+ * trilinear finite elements, in which each vertex is joined to every vertex
+ * of the elements around it (a 9 or 27 point stencil).
+ */
+Graph *generate_mesh(Int nx, Int ny, Int nz = 1);
+
+/**
+ * Generate a random geometric graph: n points uniformly distributed in the
+ * unit square (dimension 2) or cube (dimension 3), with an edge between
+ * every two points closer than the radius that gives the requested average
+ * degree away from the boundary.
+ */
+Graph *generate_geometric(Int n, double average_degree, Int dimension = 2,
+                          Int seed = 1);
+
+/**
+ * Generate an R-MAT (recursive Kronecker) power-law graph with 2^scale
+ * vertices and edge_factor * 2^scale edges, each placed by recursively
+ * choosing one quadrant of the adjacency matrix with probabilities a, b, c
+ * and 1 - a - b - c. Duplicate edges and self edges are dropped, and the
+ * vertices are randomly renumbered. The defaults are those of Graph500.
+ */
+Graph *generate_rmat(Int scale, Int edge_factor = 16, double a = 0.57,
+                     double b = 0.19, double c = 0.19, Int seed = 1);
+
+/**
+ * Generate an Erdos-Renyi graph with n vertices and n * average_degree / 2
+ * edges whose endpoints are chosen uniformly at random. The few duplicate
+ * edges and self edges are dropped.
+ */
+Graph *generate_erdos_renyi(Int n, double average_degree, Int seed = 1);
+
+/**
+ * Generate a graph from a specification family:size[:seed], where family
+ * and size are one of
+ *
+ *     grid2d:k  grid3d:k    a k-by-k or k-by-k-by-k grid
+ *     mesh2d:k  mesh3d:k    a k-by-k or k-by-k-by-k finite element mesh
+ *     geo2d:n   geo3d:n     a random geometric graph of average degree 10
+ *     rmat:s                an R-MAT graph with 2^s vertices
+ *     er:n                  an Erdos-Renyi graph of average degree 10
+ */
+Graph *generate_graph(const std::string &spec);
+Graph *generate_graph(const char *spec);
+
+/* true if name has the form of a generate_graph specification */
+bool isGeneratorSpec(const std::string &name);
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,62 @@
+/* ========================================================================== */
+/* === Include/Mongoose_GraphFormats.hpp ==================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Parallel readers for METIS/Chaco graph files and binary edge lists
+ *
+ * Both readers produce a triplet matrix, which is turned into a Graph by the
+ * same fused sanitize step used for Matrix Market files.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_GRAPHFORMATS_HPP
+#define MONGOOSE_GRAPHFORMATS_HPP
+
+#include "Mongoose_CSparse.hpp"
+#include "Mongoose_Internal.hpp"
+#include <cstdio>
+
+namespace Mongoose
+{
+
+/**
+ * Read a METIS or Chaco graph file into a triplet matrix.
+ *
+ * Every adjacency list entry becomes one triplet, so each edge appears once
+ * in each direction. Vertex sizes (METIS) or vertex numbers (Chaco) are
+ * skipped, and only the first of several vertex weights is kept.
+ *
+ * @param file the open graph file, positioned at its start.
+ * @param vertexWeights receives a new array of n vertex weights, or NULL if
+ *   the file has none.
+ * @return the triplet matrix, with no values if the file has no edge
+ *   weights, or NULL if the file is invalid or memory runs out.
+ */
+cs *readMetisTriplets(FILE *file, double **vertexWeights);
+
+/**
+ * Read a binary edge list into a triplet matrix.
+ *
+ * The file is a sequence of (u, v) or (u, v, w) records in native byte
+ * order, with 0-based vertex indices of indexWidth bytes each and a double
+ * edge weight. The number of vertices is one more than the largest index.
+ *
+ * @param file the open edge list file, positioned at its start.
+ * @param indexWidth 4 or 8.
+ * @param weighted true if each record ends with an edge weight.
+ * @return the triplet matrix, or NULL if the file is invalid or memory runs
+ *   out.
+ */
+cs *readEdgeListTriplets(FILE *file, size_t indexWidth, bool weighted);
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,77 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Gzip.hpp ============================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Streaming decompression of gzip-compressed text files
+ *
+ * A GzipStream inflates its file on a thread of its own and hands out the
+ * decompressed text as line-aligned blocks, so that a reader can parse one
+ * block while the next one is being decompressed. Only a few blocks are ever
+ * held in memory. zlib is optional; without it, create() reports an error.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_GZIP_HPP
+#define MONGOOSE_GZIP_HPP
+
+#include "Mongoose_Internal.hpp"
+
+#include <cstdio>
+
+namespace Mongoose
+{
+
+/**
+ * Check for the gzip magic number at the start of an open file. The file
+ * position is restored.
+ */
+bool isGzipFile(FILE *file);
+
+class GzipStream
+{
+public:
+    /**
+     * Open a gzip-compressed file and start decompressing it.
+     *
+     * @return the stream, or NULL if the file cannot be opened, memory runs
+     *   out, or Mongoose was built without zlib.
+     */
+    static GzipStream *create(const char *filename);
+
+    /**
+     * Get the next block of decompressed text. Each block ends with a
+     * newline, except possibly the last one, and stays valid until the next
+     * call.
+     *
+     * @return false at the end of the file or if decompression failed, which
+     *   failed() tells apart.
+     */
+    bool next(const char *&data, const char *&end);
+
+    bool failed();
+
+    ~GzipStream();
+
+private:
+    /* Blocks, queues and the inflater thread, kept out of this header so
+     * that it does not depend on zlib or the C++ threading headers. */
+    struct State;
+
+    void *file; /* the gzFile */
+    State *state;
+
+    GzipStream();
+    void inflateBlocks();
+};
+
+} // end namespace Mongoose
+
+#endif
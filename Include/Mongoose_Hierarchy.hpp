@@ -0,0 +1,103 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Hierarchy.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Saving and reloading the coarsening hierarchy
+ *
+ * Matching and coarsening depend only on the graph and a few options, so the
+ * levels they produce can be written to a file once and partitioned many
+ * times, with different seeds or refinement options, starting directly from
+ * the guess cut. The file is laid out so that it can be memory mapped and
+ * used in place.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_HIERARCHY_HPP
+#define MONGOOSE_HIERARCHY_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_Graph.hpp"
+#include "Mongoose_Internal.hpp"
+#include <string>
+
+namespace Mongoose
+{
+
+/**
+ * Coarsen a Graph as edge_cut would and save every level to a file.
+ *
+ * Each level's graph (p, i, x and w) is written along with the matching that
+ * links it to the next coarser level (matching, matchmap, invmatchmap and
+ * matchtype), each array starting on an 8 byte boundary after a header and a
+ * table of levels. The options used are the matching and coarsening options
+ * and the random seed; options->component_strategy is ignored.
+ *
+ * @param graph the (sanitized) graph to coarsen.
+ * @param options the options to coarsen with.
+ * @param filename the filename or path of the file to create.
+ * @return true if the file was written.
+ */
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const std::string &filename);
+
+/**
+ * Coarsen a Graph as edge_cut would and save every level to a file.
+ *
+ * Each level's graph (p, i, x and w) is written along with the matching that
+ * links it to the next coarser level (matching, matchmap, invmatchmap and
+ * matchtype), each array starting on an 8 byte boundary after a header and a
+ * table of levels. The options used are the matching and coarsening options
+ * and the random seed; options->component_strategy is ignored.
+ *
+ * @param graph the (sanitized) graph to coarsen.
+ * @param options the options to coarsen with.
+ * @param filename the filename or path of the file to create.
+ * @return true if the file was written.
+ */
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const char *filename);
+
+/**
+ * Partition the graph of a saved coarsening hierarchy.
+ *
+ * The hierarchy written by write_hierarchy is memory mapped where possible,
+ * and edge_cut continues from the guess cut on its coarsest level, skipping
+ * matching and coarsening. The matching and coarsening options are therefore
+ * ignored. With a matching strategy that does not draw random numbers (all
+ * but Random) and the same options, the result is the same as edge_cut's.
+ *
+ * @param filename the filename or path of the hierarchy file.
+ * @param options the options to partition with.
+ * @return the edge cut, or NULL if the file cannot be read or memory runs out.
+ */
+EdgeCut *edge_cut_hierarchy(const std::string &filename,
+                            const EdgeCut_Options *options);
+
+/**
+ * Partition the graph of a saved coarsening hierarchy.
+ *
+ * The hierarchy written by write_hierarchy is memory mapped where possible,
+ * and edge_cut continues from the guess cut on its coarsest level, skipping
+ * matching and coarsening. The matching and coarsening options are therefore
+ * ignored. With a matching strategy that does not draw random numbers (all
+ * but Random) and the same options, the result is the same as edge_cut's.
+ *
+ * @param filename the filename or path of the hierarchy file.
+ * @param options the options to partition with.
+ * @return the edge cut, or NULL if the file cannot be read or memory runs out.
+ */
+EdgeCut *edge_cut_hierarchy(const char *filename,
+                            const EdgeCut_Options *options);
+
+} // end namespace Mongoose
+
+#endif
@@ -23,8 +23,10 @@
 #define MONGOOSE_IO_HPP
 
 #include "Mongoose_CSparse.hpp"
+#include "Mongoose_EdgeCut.hpp"
 #include "Mongoose_Graph.hpp"
 #include "Mongoose_Internal.hpp"
+#include <cstdio>
 #include <string>
 
 extern "C"
@@ -40,9 +42,11 @@ namespace Mongoose
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed. A gzip-compressed file is decompressed while
+ * it is being parsed, if Mongoose was built with zlib. All connected
+ * components are kept; use largest_component, or the component_strategy
+ * option of edge_cut, to handle a graph with more than one.
  *
  * @param filename the filename or path to the Matrix Market File.
  */
@@ -53,9 +57,8 @@ Graph *read_graph(const std::string &filename);
  *
  * Generate a cs struct instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed.
  *
  * @param filename the filename or path to the Matrix Market File.
  * @param matcode the four character Matrix Market type code.
@@ -67,9 +70,11 @@ cs *read_matrix(const std::string &filename, MM_typecode &matcode);
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed. A gzip-compressed file is decompressed while
+ * it is being parsed, if Mongoose was built with zlib. All connected
+ * components are kept; use largest_component, or the component_strategy
+ * option of edge_cut, to handle a graph with more than one.
  *
  * @param filename the filename or path to the Matrix Market File.
  */
@@ -80,15 +85,181 @@ Graph *read_graph(const char *filename);
  *
  * Generate a cs struct instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If a diagonal is
+ * present, it will be removed.
  *
  * @param filename the filename or path to the Matrix Market File.
  * @param matcode the four character Matrix Market type code.
  */
 cs *read_matrix(const char *filename, MM_typecode &matcode);
 
+/**
+ * Generate a Graph from a METIS or Chaco graph file.
+ *
+ * The header line gives the number of vertices and edges and, optionally, a
+ * format code saying whether edge weights, vertex weights and vertex sizes
+ * follow. Each following line (other than % comments) lists the 1-based
+ * neighbors of one vertex. Vertex sizes are ignored, and of several vertex
+ * weights only the first is kept. The file is parsed on multiple threads.
+ *
+ * @param filename the filename or path to the graph file.
+ */
+Graph *read_graph_metis(const std::string &filename);
+
+/**
+ * Generate a Graph from a METIS or Chaco graph file.
+ *
+ * The header line gives the number of vertices and edges and, optionally, a
+ * format code saying whether edge weights, vertex weights and vertex sizes
+ * follow. Each following line (other than % comments) lists the 1-based
+ * neighbors of one vertex. Vertex sizes are ignored, and of several vertex
+ * weights only the first is kept. The file is parsed on multiple threads.
+ *
+ * @param filename the filename or path to the graph file.
+ */
+Graph *read_graph_metis(const char *filename);
+
+/**
+ * Generate a Graph from a binary edge list.
+ *
+ * The file is a sequence of records in native byte order, each holding two
+ * 0-based vertex indices of indexWidth bytes and, if weighted, a double edge
+ * weight. Each edge should be listed once; duplicates are summed and self
+ * edges are removed. The number of vertices is one more than the largest
+ * index.
+ *
+ * @param filename the filename or path to the edge list file.
+ * @param indexWidth the size of each vertex index in bytes, 4 or 8.
+ * @param weighted true if each record ends with an edge weight.
+ */
+Graph *read_graph_edgelist(const std::string &filename,
+                           size_t indexWidth = sizeof(Int),
+                           bool weighted     = true);
+
+/**
+ * Generate a Graph from a binary edge list.
+ *
+ * The file is a sequence of records in native byte order, each holding two
+ * 0-based vertex indices of indexWidth bytes and, if weighted, a double edge
+ * weight. Each edge should be listed once; duplicates are summed and self
+ * edges are removed. The number of vertices is one more than the largest
+ * index.
+ *
+ * @param filename the filename or path to the edge list file.
+ * @param indexWidth the size of each vertex index in bytes, 4 or 8.
+ * @param weighted true if each record ends with an edge weight.
+ */
+Graph *read_graph_edgelist(const char *filename,
+                           size_t indexWidth = sizeof(Int),
+                           bool weighted     = true);
+
+/**
+ * Generate a Graph from a Mongoose binary graph file.
+ *
+ * The file holds an already sanitized graph, as written by write_graph_binary,
+ * so no parsing or sanitizing is needed. Where possible the file is memory
+ * mapped and the Graph arrays point directly into the mapping, which is
+ * released when the Graph is destroyed. The arrays are mapped copy-on-write,
+ * so the file itself is never modified.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const std::string &filename);
+
+/**
+ * Generate a Graph from a Mongoose binary graph file.
+ *
+ * The file holds an already sanitized graph, as written by write_graph_binary,
+ * so no parsing or sanitizing is needed. Where possible the file is memory
+ * mapped and the Graph arrays point directly into the mapping, which is
+ * released when the Graph is destroyed. The arrays are mapped copy-on-write,
+ * so the file itself is never modified.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const char *filename);
+
+/**
+ * Write a Graph to a Mongoose binary graph file.
+ *
+ * The file starts with a 64 byte header (magic, format version, index width,
+ * byte order, weight flags, n and nz) followed by p, i, and the optional edge
+ * weights x and vertex weights w, each starting on an 8 byte boundary.
+ *
+ * @param graph the (sanitized) graph to write.
+ * @param filename the filename or path of the file to create.
+ * @param compactIndices store p and i as 32-bit integers if they fit, which
+ *   halves their size but means they are widened on load rather than mapped.
+ * @return true if the file was written.
+ */
+bool write_graph_binary(const Graph *graph, const std::string &filename,
+                        bool compactIndices = false);
+
+/**
+ * Write a Graph to a Mongoose binary graph file.
+ *
+ * The file starts with a 64 byte header (magic, format version, index width,
+ * byte order, weight flags, n and nz) followed by p, i, and the optional edge
+ * weights x and vertex weights w, each starting on an 8 byte boundary.
+ *
+ * @param graph the (sanitized) graph to write.
+ * @param filename the filename or path of the file to create.
+ * @param compactIndices store p and i as 32-bit integers if they fit, which
+ *   halves their size but means they are widened on load rather than mapped.
+ * @return true if the file was written.
+ */
+bool write_graph_binary(const Graph *graph, const char *filename,
+                        bool compactIndices = false);
+
+/**
+ * Write the partition of an edge cut to a file.
+ *
+ * Text output has one "vertex part" line per vertex. Binary output is a
+ * 32 byte header followed by the partition packed eight vertices to a byte,
+ * bit k % 8 of byte k / 8 holding vertex k. Permutation output lists the
+ * vertices in part 0 and then those in part 1, one per line, which is the
+ * order in which to permute a matrix so that the parts form its diagonal
+ * blocks. Vertices are numbered from 0. If the cut covers only part of a
+ * graph (cut->vertex_map is not NULL), text and permutation output give the
+ * original vertex numbers, and binary output appends them as 64-bit integers.
+ *
+ * @param cut the edge cut to write.
+ * @param filename the filename or path of the file to create.
+ * @param format PartitionFormat_Text, PartitionFormat_Binary or
+ *   PartitionFormat_Permutation.
+ * @return true if the file was written.
+ */
+bool write_partition(const EdgeCut *cut, const std::string &filename,
+                     PartitionFormat format = PartitionFormat_Text);
+
+/**
+ * Write the partition of an edge cut to a file.
+ *
+ * Text output has one "vertex part" line per vertex. Binary output is a
+ * 32 byte header followed by the partition packed eight vertices to a byte,
+ * bit k % 8 of byte k / 8 holding vertex k. Permutation output lists the
+ * vertices in part 0 and then those in part 1, one per line, which is the
+ * order in which to permute a matrix so that the parts form its diagonal
+ * blocks. Vertices are numbered from 0. If the cut covers only part of a
+ * graph (cut->vertex_map is not NULL), text and permutation output give the
+ * original vertex numbers, and binary output appends them as 64-bit integers.
+ *
+ * @param cut the edge cut to write.
+ * @param filename the filename or path of the file to create.
+ * @param format PartitionFormat_Text, PartitionFormat_Binary or
+ *   PartitionFormat_Permutation.
+ * @return true if the file was written.
+ */
+bool write_partition(const EdgeCut *cut, const char *filename,
+                     PartitionFormat format = PartitionFormat_Text);
+
+/**
+ * Write the partition of an edge cut to an open file, for example after a
+ * header written by the caller. See write_partition above for the formats.
+ */
+bool write_partition(const EdgeCut *cut, FILE *file,
+                     PartitionFormat format = PartitionFormat_Text);
+
 } // end namespace Mongoose
 
 #endif
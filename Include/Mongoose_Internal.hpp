@@ -55,6 +55,26 @@ enum InitialEdgeCutType
     InitialEdgeCut_NaturalOrder = 2
 };
 
+enum ComponentStrategy
+{
+    Components_Together = 0,
+    Components_Largest  = 1,
+    Components_BinPack  = 2
+};
+
+enum CycleType
+{
+    Cycle_V = 0,
+    Cycle_F = 1
+};
+
+enum PartitionFormat
+{
+    PartitionFormat_Text        = 0,
+    PartitionFormat_Binary      = 1,
+    PartitionFormat_Permutation = 2
+};
+
 enum MatchType
 {
     MatchType_Orphan    = 0,
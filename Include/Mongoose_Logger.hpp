@@ -22,9 +22,12 @@
 #ifndef MONGOOSE_LOGGER_HPP
 #define MONGOOSE_LOGGER_HPP
 
+#include "Mongoose_MemoryProfiler.hpp"
+#include "Mongoose_PerfCounters.hpp"
+
+#include <chrono>
 #include <iostream>
 #include <string>
-#include <time.h>
 
 // Default Logging Levels
 #ifndef LOG_ERROR
@@ -97,13 +100,15 @@ class Logger
 private:
     static int debugLevel;
     static bool timingOn;
-    static clock_t clocks[6];
-    static float times[6];
+    // Each thread times its own calls
+    static thread_local std::chrono::steady_clock::time_point clocks[6];
+    static thread_local float times[6];
 
 public:
-    static inline void tic(TimingType timingType);
+    static inline void tic(TimingType timingType, int level = -1);
     static inline void toc(TimingType timingType);
     static inline float getTime(TimingType timingType);
+    static inline void addTime(TimingType timingType, float seconds);
     static inline int getDebugLevel();
     static void setDebugLevel(int debugType);
     static void setTimingFlag(bool tFlag);
@@ -115,20 +120,36 @@ public:
  *
  * Given a timingType (MatchingTiming, CoarseningTiming, RefinementTiming,
  * FMTiming, QPTiming, or IOTiming), a clock is started for that computation.
+ * Times are wall-clock times, so a phase that runs on several threads is
+ * not counted once per thread.
  * The general structure is to call tic(IOTiming) at the beginning of an I/O
  * operation, then call toc(IOTiming) at the end of the I/O operation.
  *
  * Note that problems can occur and timing results may be inaccurate if a tic
  * is followed by another tic (or a toc is followed by another toc).
  *
+ * If hardware performance counters are on, they are read as well, and the
+ * counts are kept separately for each coarsening level. If the memory
+ * profiler is on, allocations until the matching toc are charged to this
+ * phase and level.
+ *
  * @param timingType The portion of the library being timed (MatchingTiming,
  *   CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
+ * @param level The coarsening level being worked on, or -1 if none.
  */
-inline void Logger::tic(TimingType timingType)
+inline void Logger::tic(TimingType timingType, int level)
 {
     if (timingOn)
     {
-        clocks[timingType] = clock();
+        clocks[timingType] = std::chrono::steady_clock::now();
+    }
+    if (PerfCounters::isCounting())
+    {
+        PerfCounters::start(timingType, level);
+    }
+    if (MemoryProfiler::isProfiling())
+    {
+        MemoryProfiler::start(timingType, level);
     }
 }
 
@@ -150,8 +171,18 @@ inline void Logger::toc(TimingType timingType)
 {
     if (timingOn)
     {
-        times[timingType]
-            += ((float)(clock() - clocks[timingType])) / CLOCKS_PER_SEC;
+        times[timingType] += std::chrono::duration<float>(
+                                 std::chrono::steady_clock::now()
+                                 - clocks[timingType])
+                                 .count();
+    }
+    if (PerfCounters::isCounting())
+    {
+        PerfCounters::stop(timingType);
+    }
+    if (MemoryProfiler::isProfiling())
+    {
+        MemoryProfiler::stop(timingType);
     }
 }
 
@@ -160,6 +191,9 @@ inline void Logger::toc(TimingType timingType)
  *
  * Retreive the total clock time for a given timing type (MatchingTiming,
  * CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
+ * Times are kept separately for each thread. An edge cut times its phases on
+ * the thread that called it, and work it hands to worker threads is added
+ * back to that thread's times (see addTime).
  *
  * @param timingType The portion of the library being timed (MatchingTiming,
  *   CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
@@ -169,6 +203,22 @@ inline float Logger::getTime(TimingType timingType)
     return times[timingType];
 }
 
+/**
+ * Add time to a given timing type on the calling thread.
+ *
+ * Used to move the time of phases run on a worker thread on behalf of
+ * another thread: the worker takes it off its own times with a negative
+ * number of seconds, and the other thread adds it to its own.
+ *
+ * @param timingType The portion of the library being timed (MatchingTiming,
+ *   CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
+ * @param seconds The time to add.
+ */
+inline void Logger::addTime(TimingType timingType, float seconds)
+{
+    times[timingType] += seconds;
+}
+
 inline int Logger::getDebugLevel()
 {
     return debugLevel;
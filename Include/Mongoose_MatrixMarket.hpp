@@ -0,0 +1,75 @@
+/* ========================================================================== */
+/* === Include/Mongoose_MatrixMarket.hpp ==================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Fast parallel reader for the data section of a Matrix Market file
+ *
+ * The file is memory mapped and split into line-aligned chunks. Each chunk is
+ * parsed by its own thread with a hand-written integer and floating point
+ * parser, and the triplets are written directly into the caller's arrays.
+ * Gzip-compressed files are streamed through the same parser.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_MATRIXMARKET_HPP
+#define MONGOOSE_MATRIXMARKET_HPP
+
+#include "Mongoose_Internal.hpp"
+#include <cstdio>
+
+namespace Mongoose
+{
+
+/**
+ * Read the coordinate entries of a Matrix Market file.
+ *
+ * The file must be positioned just past the size line, as left by
+ * mm_read_mtx_crd_size. The 1-based indices are converted to 0-based, and for
+ * pattern matrices every value is set to 1. Parsed values are identical to
+ * those read by mm_read_mtx_crd_data.
+ *
+ * @param file the open Matrix Market file.
+ * @param n the dimension of the (square) matrix, used to check the indices.
+ * @param nz the number of entries to read.
+ * @param I, J, val arrays of size nz for the row and column indices and values.
+ * @param pattern true if the file has no values.
+ * @param mapped set to false if the file could not be memory mapped, in which
+ *   case nothing is read and the caller should use mm_read_mtx_crd_data.
+ * @return true if exactly nz valid entries were read.
+ */
+bool readMatrixMarketData(FILE *file, Int n, Int nz, Int *I, Int *J,
+                          double *val, bool pattern, bool &mapped);
+
+class GzipStream;
+
+/**
+ * Read the coordinate entries of a gzip-compressed Matrix Market file.
+ *
+ * Each block of decompressed text is parsed in parallel while the stream
+ * decompresses the next one. Parsed values are identical to those read by
+ * readMatrixMarketData.
+ *
+ * @param stream the decompressed file, positioned just past the block that
+ *   holds the size line.
+ * @param data, end the rest of that block, after the size line.
+ * @param n the dimension of the (square) matrix, used to check the indices.
+ * @param nz the number of entries to read.
+ * @param I, J, val arrays of size nz for the row and column indices and values.
+ * @param pattern true if the file has no values.
+ * @return true if exactly nz valid entries were read.
+ */
+bool readMatrixMarketStream(GzipStream *stream, const char *data,
+                            const char *end, Int n, Int nz, Int *I, Int *J,
+                            double *val, bool pattern);
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,107 @@
+/* ========================================================================== */
+/* === Include/Mongoose_MemoryProfiler.hpp ================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Allocation profiler on the SuiteSparse memory hooks
+ *
+ * While profiling is on, the malloc, calloc, realloc and free functions of
+ * SuiteSparse_config are replaced by wrappers that record the size of every
+ * block, so that the bytes in use and their peak are known at all times.
+ * Every allocation is charged to the innermost phase bracketed by
+ * Logger::tic and Logger::toc (or to no phase), at its coarsening level, and
+ * the largest allocations are remembered. The wrappers call the functions
+ * that were installed before profiling started, and blocks allocated before
+ * then are freed as usual without being counted. Phases are kept per
+ * thread, as are the Logger times: an allocation is charged to the innermost
+ * phase of the thread that makes it, so edge cuts running at the same time
+ * on different threads each get their own counts. The totals of each phase
+ * are summed over all threads.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_MEMORYPROFILER_HPP
+#define MONGOOSE_MEMORYPROFILER_HPP
+
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+namespace Mongoose
+{
+
+struct MemoryCounts
+{
+    int64_t allocations; /* # blocks allocated (including reallocations) */
+    int64_t bytes;       /* total size of the blocks allocated           */
+    int64_t peakBytes;   /* peak bytes in use while the phase was on     */
+};
+
+class MemoryProfiler
+{
+private:
+    static bool profilingOn;
+
+public:
+    static const int NumLargest = 10;
+
+    static inline bool isProfiling();
+
+    /**
+     * Install (or remove) the profiling wrappers. The SuiteSparse memory
+     * functions must not be changed by anyone else while profiling is on.
+     *
+     * @return true if profiling is on.
+     */
+    static bool setProfilingFlag(bool pFlag);
+
+    /* Called by Logger::tic and Logger::toc.  phase is a TimingType, and
+     * level is the coarsening level, or -1 if the phase has none. */
+    static void start(int phase, int level);
+    static void stop(int phase);
+
+    /* Discard the counts gathered so far, and restart the peak from the
+     * bytes now in use. */
+    static void clear();
+
+    static int64_t getCurrentBytes();
+    static int64_t getPeakBytes();
+
+    /**
+     * Get the counts of a phase at one level. phase -1 stands for the
+     * allocations made outside of any phase.
+     *
+     * @return false if nothing was recorded for the phase at that level.
+     */
+    static bool getCounts(int phase, int level, MemoryCounts &counts);
+
+    /* Start a new edge cut on the calling thread: reset the counts returned
+     * by getLevelCounts on this thread. */
+    static void startCall();
+
+    /* Get the counts of all phases at one level since startCall, made on the
+     * calling thread. */
+    static void getLevelCounts(int level, MemoryCounts &counts);
+
+    /**
+     * Print the bytes in use, the peak, the counts of each phase at each
+     * level, and the largest allocations as a JSON object.
+     */
+    static void printJSON(std::ostream &out, const std::string &indent);
+};
+
+inline bool MemoryProfiler::isProfiling()
+{
+    return profilingOn;
+}
+
+} // end namespace Mongoose
+
+#endif
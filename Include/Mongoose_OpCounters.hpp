@@ -0,0 +1,94 @@
+/* ========================================================================== */
+/* === Include/Mongoose_OpCounters.hpp ====================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Counters of the basic operations on the hot paths
+ *
+ * If Mongoose is compiled with MONGOOSE_OPERATION_COUNTERS defined (the CMake
+ * option of the same name), the boundary heap, FM, the napsack solvers and
+ * coarsening count their basic operations, which shows which data structure
+ * dominates on a given graph. Each thread counts into its own thread-local
+ * counters, so counting takes no locks; a thread's counts are added to the
+ * totals when it exits. Otherwise MONGOOSE_COUNT expands to nothing, and the
+ * counts are always zero.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_OPCOUNTERS_HPP
+#define MONGOOSE_OPCOUNTERS_HPP
+
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+namespace Mongoose
+{
+
+typedef enum OperationType
+{
+    HeapInsertOp      = 0, /* bhInsert                                  */
+    HeapRemoveOp      = 1, /* bhRemove                                  */
+    HeapifyStepOp     = 2, /* swap in heapifyUp or heapifyDown          */
+    NeighborUpdateOp  = 3, /* neighbor updated by fmSwap                */
+    GainCalculationOp = 4, /* calculateGain                             */
+    NapsackHeapStepOp = 5, /* heap add or delete in QPNapUp or QPNapDown */
+    CoarsenHashHitOp  = 6, /* edge merged into an existing coarse edge  */
+    CoarsenHashMissOp = 7  /* edge starting a new coarse edge           */
+} OperationType;
+
+class OpCounters
+{
+public:
+    static const int NumOperations = 8;
+
+    /* true if Mongoose was compiled with MONGOOSE_OPERATION_COUNTERS */
+    static bool isEnabled();
+    static const char *getName(OperationType op);
+
+    /**
+     * Get the counts of the threads that have exited and of those still
+     * running. The counts of a running thread are only exact if it is not
+     * counting at the same time.
+     */
+    static void getCounts(int64_t counts[NumOperations]);
+
+    /* Reset the counts to zero. */
+    static void clear();
+
+    /* Print the counts as a JSON object keyed by operation name. */
+    static void printJSON(std::ostream &out, const std::string &indent);
+
+#ifdef MONGOOSE_OPERATION_COUNTERS
+    struct ThreadCounts
+    {
+        int64_t count[NumOperations];
+        ThreadCounts();
+        ~ThreadCounts();
+    };
+
+    static thread_local ThreadCounts local;
+
+    static inline void count(OperationType op)
+    {
+        local.count[op]++;
+    }
+#endif
+};
+
+#ifdef MONGOOSE_OPERATION_COUNTERS
+#define MONGOOSE_COUNT(op) (OpCounters::count(op))
+#else
+#define MONGOOSE_COUNT(op) ((void)0)
+#endif
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,199 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Parallel.hpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Task parallel runtime shared by all phases
+ *
+ * Parallel work runs on one pool of worker threads, started on first use
+ * with one thread per hardware thread besides the caller. Each worker keeps
+ * its own queue of tasks: it runs its newest task first and, when its queue
+ * is empty, steals the oldest task of another. A thread waiting for a
+ * TaskGroup runs queued tasks in the meantime, so parallel loops nested in
+ * tasks (or edge cuts run as tasks) share the same threads instead of
+ * starting more. With threadLimit() set to 1, everything runs serially on
+ * the calling thread.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_PARALLEL_HPP
+#define MONGOOSE_PARALLEL_HPP
+
+#include "Mongoose_Internal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Mongoose
+{
+
+/**
+ * The most threads a parallel loop may use, or 0 to use every hardware
+ * thread. Benchmarks set it to measure scaling with the number of threads.
+ */
+inline std::atomic<size_t> &threadLimit()
+{
+    static std::atomic<size_t> limit(0);
+    return limit;
+}
+
+/* Number of hardware threads, limited by threadLimit() */
+inline size_t maxThreads()
+{
+    size_t numThreads = std::thread::hardware_concurrency();
+    size_t limit      = threadLimit().load();
+    numThreads        = std::max<size_t>(1, numThreads);
+    return (limit > 0) ? std::min(numThreads, limit) : numThreads;
+}
+
+/**
+ * Number of threads worth using for work units of which each thread should
+ * get at least minWork, limited by maxThreads().
+ */
+inline size_t parallelThreads(Int work, Int minWork)
+{
+    size_t numThreads = maxThreads();
+    numThreads = std::min(numThreads, static_cast<size_t>(work / minWork));
+    return std::max<size_t>(1, numThreads);
+}
+
+/**
+ * A set of tasks run by the thread pool. wait() (or the destructor) returns
+ * once every task spawned in the group has finished. The thread that creates
+ * the group runs its tasks while it waits, and at most maxThreads() - 1
+ * other threads (as of the group's creation) help it, so that no more than
+ * maxThreads() threads work on the group at once.
+ */
+class TaskGroup
+{
+public:
+    TaskGroup();
+    ~TaskGroup();
+
+    /* Queue task() to run on any thread. It is run at once on the calling
+     * thread if the run is serial or the task cannot be queued. */
+    template <typename Task> void spawn(const Task &task);
+
+    /* Run queued tasks until those of this group have all finished */
+    void wait();
+
+private:
+    std::atomic<size_t> pending;
+    std::atomic<size_t> helpers;   /* # of other threads running its tasks */
+    size_t maxHelpers;
+    std::atomic<bool> saturated;   /* a helper was turned away             */
+    std::thread::id owner;
+
+    bool queue(std::function<void()> &task);
+    bool admit();
+    friend struct ThreadPool;
+};
+
+template <typename Task> void TaskGroup::spawn(const Task &task)
+{
+    if (maxThreads() > 1)
+    {
+        try
+        {
+            std::function<void()> queued(task);
+            if (queue(queued))
+                return;
+        }
+        catch (...)
+        {
+            // Out of memory: run the task here
+        }
+    }
+    task();
+}
+
+/**
+ * Run task(t) for t = 0..numThreads-1, using the calling thread for t = 0.
+ * The tasks may run at the same time, but none may wait for another.
+ */
+template <typename Task> void runThreads(size_t numThreads, const Task &task)
+{
+    TaskGroup group;
+    for (size_t t = 1; t < numThreads; t++)
+        group.spawn([&task, t] { task(t); });
+    task(0);
+    group.wait();
+}
+
+/* Number of ranges to split a loop into, several per thread so that a
+ * thread that finishes early can steal the ranges of a slower one. */
+inline size_t parallelRanges(Int n, Int grain)
+{
+    size_t numThreads = parallelThreads(n, grain);
+    if (numThreads == 1)
+        return 1;
+    return std::min(4 * numThreads,
+                    static_cast<size_t>(n / std::max<Int>(1, grain)));
+}
+
+/**
+ * Run body(i0, i1) on consecutive ranges that together cover begin..end-1,
+ * each of about grain iterations or more.
+ */
+template <typename Body>
+void parallelFor(Int begin, Int end, Int grain, const Body &body)
+{
+    Int n = end - begin;
+    if (n <= 0)
+        return;
+
+    size_t numRanges = parallelRanges(n, grain);
+    runThreads(numRanges, [&](size_t r) {
+        body(begin + static_cast<Int>(n * r / numRanges),
+             begin + static_cast<Int>(n * (r + 1) / numRanges));
+    });
+}
+
+/**
+ * Reduce begin..end-1 in parallel: map(i0, i1) reduces one range, and the
+ * results of the ranges are combined in order, starting from identity.
+ */
+template <typename Value, typename Map, typename Combine>
+Value parallelReduce(Int begin, Int end, Int grain, Value identity,
+                     const Map &map, const Combine &combine)
+{
+    Int n = end - begin;
+    if (n <= 0)
+        return identity;
+
+    size_t numRanges = parallelRanges(n, grain);
+    std::vector<Value> partial;
+    try
+    {
+        partial.resize(numRanges, identity);
+    }
+    catch (...)
+    {
+        numRanges = 1; // Out of memory: reduce serially
+    }
+    if (numRanges == 1)
+        return combine(identity, map(begin, end));
+
+    runThreads(numRanges, [&](size_t r) {
+        partial[r] = map(begin + static_cast<Int>(n * r / numRanges),
+                         begin + static_cast<Int>(n * (r + 1) / numRanges));
+    });
+    Value result = identity;
+    for (size_t r = 0; r < numRanges; r++)
+        result = combine(result, partial[r]);
+    return result;
+}
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,245 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Parse.hpp =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Shared machinery for the parallel file readers
+ *
+ * A file is memory mapped from its current position and split into
+ * line-aligned chunks, one per thread. The token parsers below work directly
+ * on the mapped bytes, which need not be NUL-terminated.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_PARSE_HPP
+#define MONGOOSE_PARSE_HPP
+
+#include "Mongoose_Internal.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace Mongoose
+{
+
+/* A read-only mapping of an open file, from its current position to EOF. */
+struct MappedFile
+{
+    void *base;       /* start of the mapping               */
+    size_t size;      /* length of the mapping              */
+    const char *data; /* first byte at the file position    */
+    const char *end;  /* one past the last byte of the file */
+};
+
+/**
+ * Map the rest of an open file into memory.
+ *
+ * @return false if memory mapping is unsupported or fails, in which case the
+ *   file position is unchanged and the caller should read the file instead.
+ */
+bool mapFile(FILE *file, MappedFile &mapped);
+void unmapFile(MappedFile &mapped);
+
+/* A line-aligned piece of a mapped file, parsed by one thread. */
+struct Chunk
+{
+    const char *begin;
+    const char *end;
+    Int count;  /* # of entries in the chunk   */
+    Int offset; /* position of its first entry */
+    Int lines;  /* # of lines in the chunk     */
+    Int line;   /* index of its first line     */
+    bool ok;
+};
+
+/**
+ * Split [data, end) into line-aligned chunks of at least minChunkSize bytes,
+ * at most one per hardware thread.
+ */
+void splitLines(const char *data, const char *end, size_t minChunkSize,
+                std::vector<Chunk> &chunks);
+
+/* Set each chunk's offset and line from the counts of those before it, and
+ * return the total count. */
+Int chunkOffsets(std::vector<Chunk> &chunks);
+
+inline bool isBlank(char c)
+{
+    return (c == ' ' || c == '\t' || c == '\r');
+}
+
+inline bool isDigit(char c)
+{
+    return (static_cast<unsigned>(c - '0') < 10);
+}
+
+/* Advance to the start of the next line. */
+inline const char *nextLine(const char *s, const char *end)
+{
+    const char *nl = static_cast<const char *>(
+        memchr(s, '\n', static_cast<size_t>(end - s)));
+    return (nl) ? nl + 1 : end;
+}
+
+/* Skip blanks, and report whether anything is left on the line. */
+inline bool moreOnLine(const char *&s, const char *end)
+{
+    while (s < end && isBlank(*s))
+        s++;
+    return (s < end && *s != '\n');
+}
+
+/* Parse a non-negative decimal integer. */
+inline bool parseIndex(const char *&s, const char *end, Int &value)
+{
+    while (s < end && isBlank(*s))
+        s++;
+    if (s < end && *s == '+')
+        s++;
+    if (s >= end || !isDigit(*s))
+        return false;
+
+    Int v      = 0;
+    int digits = 0;
+    while (s < end && isDigit(*s))
+    {
+        v = 10 * v + (*s - '0');
+        s++;
+        if (++digits > 18)
+            return false;
+    }
+    value = v;
+    return true;
+}
+
+/* Parse a floating point value.  Decimals with at most 19 significant digits,
+ * a mantissa below 2^53 and a power of ten within 1e+-22 are converted with a
+ * single correctly rounded multiply or divide, which gives exactly the same
+ * double as strtod.  Anything else is handed to strtod. */
+inline bool parseValue(const char *&s, const char *end, double &value)
+{
+    /* Powers of ten that are exactly representable as doubles. */
+    static const double exactPow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                         1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                         1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    while (s < end && isBlank(*s))
+        s++;
+
+    const char *token = s;
+    const char *p     = s;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    unsigned long long mantissa = 0;
+    int digits   = 0; /* significant digits in mantissa */
+    int exponent = 0;
+    bool any     = false;
+    bool exact   = true;
+
+    for (; p < end && isDigit(*p); p++)
+    {
+        any = true;
+        if (mantissa == 0 && *p == '0')
+            continue;
+        if (digits < 19)
+        {
+            mantissa = 10 * mantissa + static_cast<unsigned>(*p - '0');
+            digits++;
+        }
+        else
+        {
+            exact = false;
+        }
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && isDigit(*p); p++)
+        {
+            any = true;
+            if (mantissa == 0 && *p == '0')
+            {
+                exponent--;
+                continue;
+            }
+            if (digits < 19)
+            {
+                mantissa = 10 * mantissa + static_cast<unsigned>(*p - '0');
+                digits++;
+                exponent--;
+            }
+            else
+            {
+                exact = false;
+            }
+        }
+    }
+    if (any && p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExp = (*p == '-');
+            p++;
+        }
+        if (p >= end || !isDigit(*p))
+        {
+            any = false;
+        }
+        int e = 0;
+        for (; p < end && isDigit(*p); p++)
+        {
+            if (e < 100000)
+                e = 10 * e + (*p - '0');
+        }
+        exponent += (negativeExp) ? -e : e;
+    }
+
+    bool terminated = (p >= end || isBlank(*p) || *p == '\n');
+    if (any && terminated && exact && mantissa < (1ULL << 53)
+        && exponent >= -22 && exponent <= 22)
+    {
+        double v = static_cast<double>(mantissa);
+        v        = (exponent < 0) ? v / exactPow10[-exponent]
+                           : v * exactPow10[exponent];
+        value = (negative) ? -v : v;
+        s     = p;
+        return true;
+    }
+
+    /* Fall back to strtod on a NUL-terminated copy of the token, since the
+     * mapped file need not be NUL-terminated. */
+    while (p < end && !isBlank(*p) && *p != '\n')
+        p++;
+    size_t length = static_cast<size_t>(p - token);
+    char buffer[128];
+    if (length == 0 || length >= sizeof(buffer))
+        return false;
+    memcpy(buffer, token, length);
+    buffer[length] = '\0';
+
+    char *stop;
+    value = strtod(buffer, &stop);
+    s     = p;
+    return (stop == buffer + length);
+}
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,96 @@
+/* ========================================================================== */
+/* === Include/Mongoose_PerfCounters.hpp ==================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Hardware performance counters for the timed phases
+ *
+ * While counting is on, every region bracketed by Logger::tic and
+ * Logger::toc (matching, coarsening, refinement, FM, QP and I/O) also reads
+ * the CPU's cycle, instruction, cache and branch counters through Linux's
+ * perf_event_open, and the differences are summed per phase and per
+ * coarsening level. The counters follow the thread that turned counting on;
+ * threads it starts are only added when they exit, so the work done by the
+ * long-lived threads of the thread pool is not counted. Counters the kernel
+ * refuses to open (no permission, a virtual machine, or another operating
+ * system) are reported as missing, and if none can be opened counting simply
+ * stays off.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_PERFCOUNTERS_HPP
+#define MONGOOSE_PERFCOUNTERS_HPP
+
+#include <iostream>
+#include <string>
+
+namespace Mongoose
+{
+
+typedef enum PerfCounterType
+{
+    CyclesCounter          = 0,
+    InstructionsCounter    = 1,
+    CacheReferencesCounter = 2,
+    CacheMissesCounter     = 3, /* last level cache */
+    BranchesCounter        = 4,
+    BranchMissesCounter    = 5
+} PerfCounterType;
+
+class PerfCounters
+{
+private:
+    static bool countingOn;
+
+public:
+    static const int NumCounters = 6;
+
+    static inline bool isCounting();
+
+    /**
+     * Open (or close) the counters and start (or stop) counting.
+     *
+     * @return true if counting is on, which needs at least one counter.
+     */
+    static bool setCountingFlag(bool cFlag);
+    static bool isAvailable(PerfCounterType counterType);
+
+    /* Called by Logger::tic and Logger::toc.  phase is a TimingType, and
+     * level is the coarsening level, or -1 if the phase has none. */
+    static void start(int phase, int level);
+    static void stop(int phase);
+
+    /* Discard the counts gathered so far. */
+    static void clear();
+
+    /**
+     * Get the counts summed over a phase at one level.
+     *
+     * @return false if the phase never ran at that level.
+     */
+    static bool getCounts(int phase, int level, double counts[NumCounters]);
+
+    /**
+     * Print the counts as a JSON object with one array per phase, each
+     * entry holding a level, the counts (null if a counter is unavailable),
+     * the instructions per cycle, and the memory traffic estimated as 64
+     * bytes per last level cache miss.
+     */
+    static void printJSON(std::ostream &out, const std::string &indent);
+};
+
+inline bool PerfCounters::isCounting()
+{
+    return countingOn;
+}
+
+} // end namespace Mongoose
+
+#endif
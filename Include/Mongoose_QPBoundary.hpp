@@ -21,7 +21,8 @@
 namespace Mongoose
 {
 
-void QPBoundary(EdgeCutProblem *, const EdgeCut_Options *, QPDelta *);
+template <typename Float>
+void QPBoundary(EdgeCutProblem *, const EdgeCut_Options *, QPDeltaT<Float> *);
 
 } // end namespace Mongoose
 
@@ -18,14 +18,19 @@
 namespace Mongoose
 {
 
-class QPDelta
+/* The QP workspace is templated on the floating-point type used to store the
+ * per-vertex vectors (x, gradient, D and the wx workspaces).  Scalars such as
+ * lo, hi, b and lambda are always kept in double precision.  QPDelta is the
+ * double-precision instance; QPDeltaSingle stores the vectors in float, which
+ * halves the memory traffic of the QP kernels. */
+template <typename Float> class QPDeltaT
 {
 private:
     static const Int WXSIZE = 3;
     static const Int WISIZE = 2;
 
 public:
-    double *x; /* current estimate of solution                    */
+    Float *x; /* current estimate of solution                     */
 
     // FreeSet:
     Int nFreeSet;        /* number of i such that 0 < x_i < 1               */
@@ -33,15 +38,15 @@ public:
     Int *FreeSet_list;   /* list for free indices                    */
     //---
 
-    double *gradient; /* gradient at current x                           */
-    double *D;        /* max value along the column.                     */
+    Float *gradient; /* gradient at current x                           */
+    Float *D;        /* max value along the column.                     */
 
     double lo; // lo <= a'*x <= hi must always hold
     double hi;
 
     // workspace
     Int *wi[WISIZE];
-    double *wx[WXSIZE];
+    Float *wx[WXSIZE];
 
     Int its;
     double err;
@@ -52,14 +57,17 @@ public:
 
     double lambda;
 
-    static QPDelta *Create(Int numVars);
-    ~QPDelta();
+    static QPDeltaT *Create(Int numVars);
+    ~QPDeltaT();
 
 #ifndef NDEBUG
     double check_cost;
 #endif
 };
 
+typedef QPDeltaT<double> QPDelta;
+typedef QPDeltaT<float> QPDeltaSingle;
+
 } // end namespace Mongoose
 
 #endif
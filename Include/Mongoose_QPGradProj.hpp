@@ -21,7 +21,8 @@
 namespace Mongoose
 {
 
-double QPGradProj(EdgeCutProblem *, const EdgeCut_Options *, QPDelta *);
+template <typename Float>
+double QPGradProj(EdgeCutProblem *, const EdgeCut_Options *, QPDeltaT<Float> *);
 
 } // end namespace Mongoose
 
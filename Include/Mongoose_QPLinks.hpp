@@ -21,7 +21,8 @@
 namespace Mongoose
 {
 
-bool QPLinks(EdgeCutProblem *, const EdgeCut_Options *, QPDelta *);
+template <typename Float>
+bool QPLinks(EdgeCutProblem *, const EdgeCut_Options *, QPDeltaT<Float> *);
 
 } // end namespace Mongoose
 
@@ -18,25 +18,29 @@
 namespace Mongoose
 {
 
+template <typename Float>
 void QPMinHeap_build(Int *heap, /* on input, an unsorted set of elements */
                      Int size,  /* size of the heap */
-                     double *x);
+                     Float *x);
 
+template <typename Float>
 Int QPMinHeap_delete /* return new size of heap */
     (Int *heap,      /* containing indices into x, 1..n on input */
      Int size,       /* size of the heap */
-     const double *x /* not modified */
+     const Float *x  /* not modified */
     );
 
+template <typename Float>
 void QPMinHeapify(Int p,          /* start at vertex p in the heap */
                   Int *heap,      /* size n, containing indices into x */
                   Int size,       /* heap [ ... nheap] is in use */
-                  const double *x /* not modified */
+                  const Float *x  /* not modified */
 );
 
+template <typename Float>
 Int QPMinHeap_add(Int leaf,        /* the new leaf */
                   Int *heap,       /* size n, containing indices into x */
-                  const double *x, /* not modified */
+                  const Float *x,  /* not modified */
                   Int size /* number of elements in heap not counting new one */
 );
 
@@ -9,15 +9,68 @@
  * Mongoose is also available under other licenses; contact authors for details.
  * -------------------------------------------------------------------------- */
 
+/**
+ * Counter-based random numbers
+ *
+ * Every random number is a hash of a key and a counter rather than the next
+ * number of a sequential generator. A key is derived from the random_seed
+ * option and a stream, such as a coarsening level, and the counter is
+ * usually a vertex (or edge) and a draw number. A random choice is thus a
+ * pure function of its arguments: it does not depend on which thread makes
+ * it or in which order, so randomized phases give the same result with any
+ * number of threads.
+ */
+
 // #pragma once
 #ifndef MONGOOSE_RANDOM_HPP
 #define MONGOOSE_RANDOM_HPP
 
 #include "Mongoose_Internal.hpp"
 
+#include <stdint.h>
+
 namespace Mongoose
 {
 
+/* The splitmix64 finalizer, a bijective mixing of 64 bits */
+inline uint64_t randomMix(uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* The key of one stream of random numbers of a seed */
+inline uint64_t randomKey(Int seed, Int stream)
+{
+    return randomMix(static_cast<uint64_t>(seed)
+                     ^ randomMix(static_cast<uint64_t>(stream)
+                                 + 0x2545F4914F6CDD1DULL));
+}
+
+/* Random 64 bits for draw number draw of item k */
+inline uint64_t randomBits(uint64_t key, uint64_t k, uint64_t draw = 0)
+{
+    return randomMix(randomMix(key ^ randomMix(k)) + draw);
+}
+
+/* Random draw number draw for item k, uniform in [0, 1) */
+inline double randomUniform(uint64_t key, uint64_t k, uint64_t draw = 0)
+{
+    return static_cast<double>(randomBits(key, k, draw) >> 11)
+           * (1.0 / 9007199254740992.0);
+}
+
+/* Random draw number draw for item k, uniform in 0..n-1 */
+inline Int randomIndex(uint64_t key, uint64_t k, uint64_t draw, Int n)
+{
+    Int index = static_cast<Int>(randomUniform(key, k, draw) * n);
+    return (index < n) ? index : n - 1;
+}
+
+/* A sequence of random numbers in 0..2^31-1, for serial code. Each thread
+ * has its own sequence, restarted by setRandomSeed. */
 Int random();
 void setRandomSeed(Int seed);
 
@@ -21,6 +21,10 @@ namespace Mongoose
 
 cs *sanitizeMatrix(cs *compressed_A, bool symmetricTriangular,
                    bool makeEdgeWeightsBinary);
+// Builds the sanitized CSC matrix directly from the triplet matrix T, which is
+// freed (arrays included) whether or not the build succeeds.
+cs *sanitizeTriplets(cs *T, bool symmetricTriangular,
+                     bool makeEdgeWeightsBinary);
 void removeDiagonal(cs *A);
 // Requires A to be a triangular matrix with no diagonal.
 cs *mirrorTriangular(cs *A);
@@ -0,0 +1,106 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Trace.hpp =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Hierarchical wall-clock tracing
+ *
+ * While tracing is on, each phase of the library (matching, coarsening, the
+ * guess cut, refinement, the waterdance, FM, QP and its parts, and file I/O)
+ * is recorded as a span with its start time, duration, thread and coarsening
+ * level, measured with a monotonic clock. Spans nest, and can be written out
+ * as a Chrome trace to be viewed with chrome://tracing or Perfetto. While
+ * tracing is off, a span costs a single test of a flag.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_TRACE_HPP
+#define MONGOOSE_TRACE_HPP
+
+#include "Mongoose_Internal.hpp"
+#include <stdint.h>
+#include <string>
+
+namespace Mongoose
+{
+
+class Trace
+{
+private:
+    static bool tracingOn;
+
+public:
+    static inline bool isTracing();
+    static void setTracingFlag(bool tFlag);
+
+    /* Discard the spans recorded so far. */
+    static void clear();
+    static Int getNumSpans();
+
+    /**
+     * Write the recorded spans as a Chrome trace (JSON) file. Each span is a
+     * complete ("X") event with its coarsening level, if it has one, in args.
+     *
+     * @return true if the file was written.
+     */
+    static bool writeChromeTrace(const std::string &filename);
+    static bool writeChromeTrace(const char *filename);
+
+    /* Nanoseconds on a monotonic clock. */
+    static int64_t now();
+
+    /* Record a finished span.  name must outlive the trace, and level is -1
+     * for spans that do not belong to a coarsening level. */
+    static void record(const char *name, Int level, int64_t start,
+                       int64_t end);
+};
+
+inline bool Trace::isTracing()
+{
+    return tracingOn;
+}
+
+/**
+ * A span that lasts from its construction to the end of the enclosing scope.
+ *
+ *     TraceSpan span("Matching", graph->clevel);
+ */
+class TraceSpan
+{
+public:
+    inline TraceSpan(const char *_name, Int _level = -1)
+    {
+        name = NULL;
+        if (Trace::isTracing())
+        {
+            name  = _name;
+            level = _level;
+            start = Trace::now();
+        }
+    }
+
+    inline ~TraceSpan()
+    {
+        if (name)
+            Trace::record(name, level, start, Trace::now());
+    }
+
+private:
+    const char *name; /* NULL if tracing was off at the start */
+    Int level;
+    int64_t start;
+
+    TraceSpan(const TraceSpan &);
+    TraceSpan &operator=(const TraceSpan &);
+};
+
+} // end namespace Mongoose
+
+#endif
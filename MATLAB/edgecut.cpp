@@ -33,10 +33,39 @@ void mexFunction
     if(!O)
         mexErrMsgTxt("Unable to get Options struct");
 
-    EdgeCut *result = edge_cut(G, O);
-    
-    // Copy the partition choices back to MATLAB.
-    pargout[0] = gp_mex_put_logical(result->partition, result->n);
+    EdgeCut *result;
+    if(O->component_strategy == Components_Together)
+    {
+        result = edge_cut(G, O);
+    }
+    else
+    {
+        // Components are found on a Graph that shares the arrays of G.
+        Graph *graph = Graph::create(G->n, G->nz, G->p, G->i, G->x, G->w);
+        result = (graph) ? edge_cut(graph, O) : NULL;
+        if(graph) graph->~Graph();
+    }
+
+    if(!result)
+    {
+        O->~EdgeCut_Options();
+        G->~EdgeCutProblem();
+        mexErrMsgTxt("Unable to compute edge cut");
+    }
+
+    // Copy the partition choices back to MATLAB. If only part of the graph
+    // was partitioned, the other vertices are reported in part 0.
+    if(result->vertex_map)
+    {
+        pargout[0] = mxCreateDoubleMatrix(1, G->n, mxREAL);
+        double *x = mxGetPr(pargout[0]);
+        for(Int k = 0; k < result->n; k++)
+            x[result->vertex_map[k]] = result->partition[k] ? 1.0 : 0.0;
+    }
+    else
+    {
+        pargout[0] = gp_mex_put_logical(result->partition, result->n);
+    }
 
     // Cleanup
     O->~EdgeCut_Options();
@@ -10,7 +10,9 @@ function partition = edgecut(G, O, A)   %#ok
 %   all vertex weights are 1). The partition is returned as a binary array.
 %
 %   partition = EDGECUT(G, O) uses the options struct to define how the edge
-%   cut algorithms are run.
+%   cut algorithms are run. If O.component_strategy selects the largest
+%   connected component, only that component is partitioned, and all other
+%   vertices are returned in part 0.
 %
 %   partition = EDGECUT(G, O, A) initializes the graph with vertex weights
 %   provided in the array A such that A(i) is the vertex weight of vertex i.
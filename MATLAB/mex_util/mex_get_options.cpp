@@ -21,6 +21,7 @@ EdgeCut_Options *mex_get_options
         return returner;
 
     MEX_STRUCT_READINT(random_seed);
+    MEX_STRUCT_READENUM(component_strategy, ComponentStrategy);
     MEX_STRUCT_READINT(coarsen_limit);
     MEX_STRUCT_READENUM(matching_strategy, MatchingStrategy);
     MEX_STRUCT_READBOOL(do_community_matching);
@@ -29,8 +30,25 @@ EdgeCut_Options *mex_get_options
     /** Guess Partitioning Options *******************************************/
     MEX_STRUCT_READENUM(initial_cut_type, InitialEdgeCutType);
 
+    /** Multilevel Cycle Options *********************************************/
+    MEX_STRUCT_READINT(num_cycles);
+    MEX_STRUCT_READENUM(cycle_type, CycleType);
+    MEX_STRUCT_READDOUBLE(cycle_min_improvement);
+    MEX_STRUCT_READDOUBLE(cycle_time_budget);
+
+    /** Evolution Options ****************************************************/
+    MEX_STRUCT_READBOOL(use_evolution);
+    MEX_STRUCT_READINT(evolution_population);
+    MEX_STRUCT_READINT(evolution_generations);
+    MEX_STRUCT_READDOUBLE(evolution_mutation_rate);
+    MEX_STRUCT_READDOUBLE(evolution_time_budget);
+
     /** Waterdance Options ***************************************************/
     MEX_STRUCT_READINT(num_dances);
+    MEX_STRUCT_READBOOL(use_adaptive_waterdance);
+    MEX_STRUCT_READDOUBLE(waterdance_min_payoff);
+    MEX_STRUCT_READINT(waterdance_max_dances);
+    MEX_STRUCT_READDOUBLE(waterdance_time_budget);
 
     /**** Fidducia-Mattheyes Options *****************************************/
     MEX_STRUCT_READBOOL(use_FM);
@@ -42,11 +60,16 @@ EdgeCut_Options *mex_get_options
     MEX_STRUCT_READBOOL(use_QP_gradproj);
     MEX_STRUCT_READDOUBLE(gradproj_tolerance);
     MEX_STRUCT_READINT(gradproj_iteration_limit);
+    MEX_STRUCT_READBOOL(use_QP_single_precision);
+    MEX_STRUCT_READBOOL(use_QP_prolongation);
 
     /** Final Partition Target Metrics ***************************************/
     MEX_STRUCT_READDOUBLE(target_split);
     MEX_STRUCT_READDOUBLE(soft_split_tolerance);
 
+    /** Diagnostics **********************************************************/
+    MEX_STRUCT_READBOOL(collect_stats);
+
     return returner;
 }
 
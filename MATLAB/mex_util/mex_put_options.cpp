@@ -13,6 +13,7 @@ mxArray *mex_put_options
     mxArray *returner = mxCreateStructMatrix(1, 1, 0, NULL);
 
     MEX_STRUCT_PUT(random_seed);
+    MEX_STRUCT_PUT(component_strategy);
     MEX_STRUCT_PUT(coarsen_limit);
     MEX_STRUCT_PUT(matching_strategy);
     MEX_STRUCT_PUT(do_community_matching);
@@ -21,8 +22,25 @@ mxArray *mex_put_options
     /** Guess Partitioning Options *******************************************/
     MEX_STRUCT_PUT(initial_cut_type);
 
+    /** Multilevel Cycle Options *********************************************/
+    MEX_STRUCT_PUT(num_cycles);
+    MEX_STRUCT_PUT(cycle_type);
+    MEX_STRUCT_PUT(cycle_min_improvement);
+    MEX_STRUCT_PUT(cycle_time_budget);
+
+    /** Evolution Options ****************************************************/
+    MEX_STRUCT_PUT(use_evolution);
+    MEX_STRUCT_PUT(evolution_population);
+    MEX_STRUCT_PUT(evolution_generations);
+    MEX_STRUCT_PUT(evolution_mutation_rate);
+    MEX_STRUCT_PUT(evolution_time_budget);
+
     /** Waterdance Options ***************************************************/
     MEX_STRUCT_PUT(num_dances);
+    MEX_STRUCT_PUT(use_adaptive_waterdance);
+    MEX_STRUCT_PUT(waterdance_min_payoff);
+    MEX_STRUCT_PUT(waterdance_max_dances);
+    MEX_STRUCT_PUT(waterdance_time_budget);
 
     /**** Fidducia-Mattheyes Options *****************************************/
     MEX_STRUCT_PUT(use_FM);
@@ -34,11 +52,16 @@ mxArray *mex_put_options
     MEX_STRUCT_PUT(use_QP_gradproj);
     MEX_STRUCT_PUT(gradproj_tolerance);
     MEX_STRUCT_PUT(gradproj_iteration_limit);
+    MEX_STRUCT_PUT(use_QP_single_precision);
+    MEX_STRUCT_PUT(use_QP_prolongation);
 
     /** Final Partition Target Metrics ***************************************/
     MEX_STRUCT_PUT(target_split);
     MEX_STRUCT_PUT(soft_split_tolerance);
 
+    /** Diagnostics **********************************************************/
+    MEX_STRUCT_PUT(collect_stats);
+
     return returner;
 }
 
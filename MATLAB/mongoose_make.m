@@ -56,16 +56,22 @@ config_src = {
 mongoose_src = {
     '../Source/Mongoose_BoundaryHeap', ...
     '../Source/Mongoose_Coarsening', ...
+    '../Source/Mongoose_Components', ...
     '../Source/Mongoose_CSparse', ...
     '../Source/Mongoose_EdgeCut', ...
     '../Source/Mongoose_EdgeCutOptions', ...
     '../Source/Mongoose_EdgeCutProblem', ...
+    '../Source/Mongoose_Evolution', ...
     '../Source/Mongoose_Graph', ...
     '../Source/Mongoose_GuessCut', ...
     '../Source/Mongoose_ImproveFM', ...
     '../Source/Mongoose_ImproveQP', ...
     '../Source/Mongoose_Logger', ...
     '../Source/Mongoose_Matching', ...
+    '../Source/Mongoose_MemoryProfiler', ...
+    '../Source/Mongoose_OpCounters', ...
+    '../Source/Mongoose_Parallel', ...
+    '../Source/Mongoose_PerfCounters', ...
     '../Source/Mongoose_QPBoundary', ...
     '../Source/Mongoose_QPDelta', ...
     '../Source/Mongoose_QPGradProj', ...
@@ -78,6 +84,7 @@ mongoose_src = {
     '../Source/Mongoose_Random', ...
     '../Source/Mongoose_Refinement', ...
     '../Source/Mongoose_Sanitize', ...
+    '../Source/Mongoose_Trace', ...
     '../Source/Mongoose_Waterdance' };
 
 mex_util_src = {
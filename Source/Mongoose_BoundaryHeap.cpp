@@ -14,6 +14,7 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_OpCounters.hpp"
 
 namespace Mongoose
 {
@@ -82,6 +83,36 @@ void bhLoad(EdgeCutProblem *graph, const EdgeCut_Options *options)
                              : 0.0));
 }
 
+//-----------------------------------------------------------------------------
+// Empties both boundary heaps, leaving every vertex with the gain and external
+// degree of a vertex that has all of its neighbors on its own side
+//-----------------------------------------------------------------------------
+void bhClear(EdgeCutProblem *graph)
+{
+    Int *Gp             = graph->p;
+    double *Gx          = graph->x;
+    double *gains       = graph->vertexGains;
+    Int *externalDegree = graph->externalDegree;
+
+    for (Int h = 0; h < 2; h++)
+    {
+        Int *bhHeap = graph->bhHeap[h];
+        for (Int hpos = 0; hpos < graph->bhSize[h]; hpos++)
+        {
+            Int k = bhHeap[hpos];
+
+            double sumEdgeWeights = 0.0;
+            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+                sumEdgeWeights += (Gx) ? Gx[p] : 1;
+
+            gains[k]          = -sumEdgeWeights;
+            externalDegree[k] = 0;
+            graph->bhIndex[k] = 0;
+        }
+        graph->bhSize[h] = 0;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // This function inserts the specified vertex into the graph's boundary heap
 //-----------------------------------------------------------------------------
@@ -93,6 +124,8 @@ void bhInsert(EdgeCutProblem *graph, Int vertex)
     Int size      = graph->bhSize[vp];
     double *gains = graph->vertexGains;
 
+    MONGOOSE_COUNT(HeapInsertOp);
+
     bhHeap[size] = vertex;
     graph->BH_putIndex(vertex, size);
 
@@ -113,6 +146,8 @@ void bhRemove(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex,
     (void)options; // Unused variable
     (void)gain;    // Unused variable
 
+    MONGOOSE_COUNT(HeapRemoveOp);
+
     double *gains = graph->vertexGains;
     Int *bhIndex  = graph->bhIndex;
     Int *bhHeap   = graph->bhHeap[partition];
@@ -155,6 +190,7 @@ void heapifyUp(EdgeCutProblem *graph, Int *bhHeap, double *gains, Int vertex,
     /* If we need to swap this vertex with the parent then: */
     if (pGain < gain)
     {
+        MONGOOSE_COUNT(HeapifyStepOp);
         bhHeap[posParent] = vertex;
         bhHeap[position]  = pVertex;
         graph->BH_putIndex(vertex, posParent);
@@ -183,6 +219,7 @@ void heapifyDown(EdgeCutProblem *graph, Int *bhHeap, Int size, double *gains, In
 
     if (gain < lg || gain < rg)
     {
+        MONGOOSE_COUNT(HeapifyStepOp);
         if (lg > rg)
         {
             bhHeap[position] = lv;
@@ -15,11 +15,17 @@
  * A subset of the CSparse library is used for its sparse matrix data
  * structure and efficient fundamental matrix operations, such as adding,
  * transposing, and converting from triplet to CSC form.
+ *
+ * cs_compress, cs_transpose and cs_add split large matrices across threads.
+ * Each thread keeps its own histogram, and the offsets are laid out so that
+ * every thread writes to a disjoint part of the result in the same order as
+ * the serial code. The result is therefore identical for any thread count.
  */
 #include "Mongoose_CSparse.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
 
 namespace Mongoose
 {
@@ -29,6 +35,256 @@ csi cs_scatter(const cs *A, csi j, double beta, csi *w, double *x, csi mark,
                cs *C, csi nz);
 cs *cs_done(cs *C, void *w, void *x, csi ok);
 
+namespace
+{
+
+/* Below this many entries per thread a kernel is run serially. */
+const csi MinParallelWork = 1 << 16;
+
+/* Number of threads to use for nz entries with an O(dim) workspace per
+ * thread. The workspaces are kept to about one word per entry. */
+size_t kernelThreads(csi nz, csi dim)
+{
+    size_t numThreads = parallelThreads(nz, MinParallelWork);
+    if (dim > 0)
+        numThreads = std::min(numThreads, static_cast<size_t>(nz / dim));
+    return std::max<size_t>(1, numThreads);
+}
+
+/* Split [0, Ap[n]) into numThreads ranges of columns with about the same
+ * number of entries each. Column range t is [split[t], split[t+1]). */
+void splitColumns(const csi *Ap, csi n, size_t numThreads,
+                  std::vector<csi> &split)
+{
+    split.resize(numThreads + 1);
+    split[0]          = 0;
+    split[numThreads] = n;
+    for (size_t t = 1; t < numThreads; t++)
+    {
+        csi target = static_cast<csi>(Ap[n] * t / numThreads);
+        split[t]   = std::lower_bound(Ap, Ap + n, target) - Ap;
+        split[t]   = std::max(split[t], split[t - 1]);
+    }
+}
+
+/* Parallel prefix sum over per-slice histograms. On input, counts[s*dim+j]
+ * is the number of entries that slice s puts in bucket j. On output, Cp[j] is
+ * the start of bucket j and counts[s*dim+j] is where slice s starts writing
+ * into bucket j, so that slices fill each bucket in order. */
+void bucketOffsets(csi *counts, size_t numSlices, csi dim, size_t numThreads,
+                   csi *Cp)
+{
+    std::vector<csi> base(numThreads + 1, 0);
+
+    /* Total each bucket, and each thread's range of buckets. */
+    runThreads(numThreads, [&](size_t t) {
+        csi j0 = static_cast<csi>(dim * t / numThreads);
+        csi j1 = static_cast<csi>(dim * (t + 1) / numThreads);
+        csi sum = 0;
+        for (csi j = j0; j < j1; j++)
+        {
+            csi total = 0;
+            for (size_t s = 0; s < numSlices; s++)
+                total += counts[s * dim + j];
+            Cp[j] = total;
+            sum += total;
+        }
+        base[t + 1] = sum;
+    });
+    for (size_t t = 0; t < numThreads; t++)
+        base[t + 1] += base[t];
+
+    /* Turn the totals into bucket starts and the counts into offsets. */
+    runThreads(numThreads, [&](size_t t) {
+        csi j0 = static_cast<csi>(dim * t / numThreads);
+        csi j1 = static_cast<csi>(dim * (t + 1) / numThreads);
+        csi nz = base[t];
+        for (csi j = j0; j < j1; j++)
+        {
+            Cp[j] = nz;
+            for (size_t s = 0; s < numSlices; s++)
+            {
+                csi c               = counts[s * dim + j];
+                counts[s * dim + j] = nz;
+                nz += c;
+            }
+        }
+    });
+    Cp[dim] = base[numThreads];
+}
+
+cs *cs_transpose_parallel(const cs *A, csi values, size_t numThreads)
+{
+    csi m = A->m, n = A->n, *Ap = A->p, *Ai = A->i;
+    double *Ax = A->x;
+    cs *C      = cs_spalloc(n, m, Ap[n], values && Ax, 0);
+    csi *counts = (csi *)SuiteSparse_calloc(numThreads * static_cast<size_t>(m),
+                                            sizeof(csi));
+    if (!C || !counts)
+        return (cs_done(C, counts, NULL, 0));
+    csi *Ci    = C->i;
+    double *Cx = C->x;
+
+    std::vector<csi> split;
+    splitColumns(Ap, n, numThreads, split);
+    runThreads(numThreads, [&](size_t t) {
+        csi *w = counts + t * m;
+        for (csi p = Ap[split[t]]; p < Ap[split[t + 1]]; p++)
+            w[Ai[p]]++; /* row counts of this slice */
+    });
+    bucketOffsets(counts, numThreads, m, numThreads, C->p);
+    runThreads(numThreads, [&](size_t t) {
+        csi *w = counts + t * m;
+        for (csi j = split[t]; j < split[t + 1]; j++)
+        {
+            for (csi p = Ap[j]; p < Ap[j + 1]; p++)
+            {
+                csi q = w[Ai[p]]++;
+                Ci[q] = j; /* place A(i,j) as entry C(j,i) */
+                if (Cx)
+                    Cx[q] = Ax[p];
+            }
+        }
+    });
+    return (cs_done(C, counts, NULL, 1));
+}
+
+cs *cs_compress_parallel(const cs *T, size_t numThreads)
+{
+    csi m = T->m, n = T->n, nz = T->nz, *Ti = T->i, *Tj = T->p;
+    double *Tx = T->x;
+    cs *C      = cs_spalloc(m, n, nz, Tx != NULL, 0);
+    csi *counts = (csi *)SuiteSparse_calloc(numThreads * static_cast<size_t>(n),
+                                            sizeof(csi));
+    if (!C || !counts)
+        return (cs_done(C, counts, NULL, 0));
+    csi *Ci    = C->i;
+    double *Cx = C->x;
+
+    runThreads(numThreads, [&](size_t t) {
+        csi *w  = counts + t * n;
+        csi k1  = static_cast<csi>(nz * (t + 1) / numThreads);
+        for (csi k = static_cast<csi>(nz * t / numThreads); k < k1; k++)
+            w[Tj[k]]++; /* column counts of this slice */
+    });
+    bucketOffsets(counts, numThreads, n, numThreads, C->p);
+    runThreads(numThreads, [&](size_t t) {
+        csi *w  = counts + t * n;
+        csi k1  = static_cast<csi>(nz * (t + 1) / numThreads);
+        for (csi k = static_cast<csi>(nz * t / numThreads); k < k1; k++)
+        {
+            csi p = w[Tj[k]]++;
+            Ci[p] = Ti[k]; /* A(i,j) is the pth entry in C */
+            if (Cx)
+                Cx[p] = Tx[k];
+        }
+    });
+    return (cs_done(C, counts, NULL, 1));
+}
+
+cs *cs_add_parallel(const cs *A, const cs *B, double alpha, double beta,
+                    size_t numThreads)
+{
+    csi m = A->m, n = B->n, *Ap = A->p, *Ai = A->i, *Bp = B->p, *Bi = B->i;
+    bool values = (A->x != NULL) && (B->x != NULL);
+
+    /* Each thread marks rows in w and accumulates values in x. */
+    csi *w = (csi *)SuiteSparse_calloc(numThreads * static_cast<size_t>(m),
+                                       sizeof(csi));
+    double *x = values ? (double *)SuiteSparse_malloc(
+                    numThreads * static_cast<size_t>(m), sizeof(double))
+                       : NULL;
+    csi *Cp = (csi *)SuiteSparse_malloc(static_cast<size_t>(n + 1),
+                                        sizeof(csi));
+    if (!w || (values && !x) || !Cp)
+    {
+        SuiteSparse_free(Cp);
+        return (cs_done(NULL, w, x, 0));
+    }
+
+    std::vector<csi> split(numThreads + 1);
+    split[0]          = 0;
+    split[numThreads] = n;
+    for (size_t t = 1; t < numThreads; t++)
+    {
+        csi target = (Ap[n] + Bp[n]) * static_cast<csi>(t)
+                     / static_cast<csi>(numThreads);
+        csi lo = split[t - 1], hi = n;
+        while (lo < hi) /* first column with Ap[j] + Bp[j] >= target */
+        {
+            csi mid = lo + (hi - lo) / 2;
+            if (Ap[mid] + Bp[mid] < target)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        split[t] = lo;
+    }
+
+    /* Symbolic pass: count the entries in each column of C. */
+    runThreads(numThreads, [&](size_t t) {
+        csi *wt = w + t * m;
+        for (csi j = split[t]; j < split[t + 1]; j++)
+        {
+            csi count = 0;
+            for (csi p = Ap[j]; p < Ap[j + 1]; p++)
+            {
+                if (wt[Ai[p]] < j + 1)
+                {
+                    wt[Ai[p]] = j + 1;
+                    count++;
+                }
+            }
+            for (csi p = Bp[j]; p < Bp[j + 1]; p++)
+            {
+                if (wt[Bi[p]] < j + 1)
+                {
+                    wt[Bi[p]] = j + 1;
+                    count++;
+                }
+            }
+            Cp[j] = count;
+        }
+    });
+    csi *counts = (csi *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                            sizeof(csi));
+    if (!counts)
+    {
+        SuiteSparse_free(Cp);
+        return (cs_done(NULL, w, x, 0));
+    }
+    std::copy(Cp, Cp + n, counts);
+    bucketOffsets(counts, 1, n, numThreads, Cp);
+    SuiteSparse_free(counts);
+
+    cs *C = cs_spalloc(m, n, Cp[n], values, 0);
+    if (!C)
+    {
+        SuiteSparse_free(Cp);
+        return (cs_done(NULL, w, x, 0));
+    }
+    SuiteSparse_free(C->p);
+    C->p = Cp;
+
+    /* Numeric pass: the marks continue past those of the symbolic pass. */
+    runThreads(numThreads, [&](size_t t) {
+        csi *wt    = w + t * m;
+        double *xt = (values) ? x + t * m : NULL;
+        double *Cx = C->x;
+        for (csi j = split[t]; j < split[t + 1]; j++)
+        {
+            csi nz = cs_scatter(A, j, alpha, wt, xt, n + j + 1, C, Cp[j]);
+            nz     = cs_scatter(B, j, beta, wt, xt, n + j + 1, C, nz);
+            if (values)
+                for (csi p = Cp[j]; p < nz; p++)
+                    Cx[p] = xt[C->i[p]];
+        }
+    });
+    return (cs_done(C, w, x, 1));
+}
+
+} // end anonymous namespace
+
 /**
  * C = A'
  *
@@ -55,6 +311,9 @@ cs *cs_transpose(const cs *A, csi values)
     cs *C;
     ASSERT(A != NULL);
     ASSERT(CS_CSC(A));
+    size_t numThreads = kernelThreads(A->p[A->n], A->m);
+    if (numThreads > 1)
+        return (cs_transpose_parallel(A, values, numThreads));
     m  = A->m;
     n  = A->n;
     Ap = A->p;
@@ -115,6 +374,9 @@ cs *cs_add(const cs *A, const cs *B, double alpha, double beta)
     ASSERT(CS_CSC(B));
     ASSERT(A->m == B->m);
     ASSERT(A->n == B->n);
+    size_t numThreads = kernelThreads(A->p[A->n] + B->p[B->n], A->m);
+    if (numThreads > 1)
+        return (cs_add_parallel(A, B, alpha, beta, numThreads));
     m      = A->m;
     anz    = A->p[A->n];
     n      = B->n;
@@ -168,6 +430,9 @@ cs *cs_compress(const cs *T)
     double *Cx, *Tx;
     cs *C;
     ASSERT(CS_TRIPLET(T));
+    size_t numThreads = kernelThreads(T->nz, T->n);
+    if (numThreads > 1)
+        return (cs_compress_parallel(T, numThreads));
     m  = T->m;
     n  = T->n;
     Ti = T->i;
@@ -22,6 +22,8 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_OpCounters.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
@@ -37,7 +39,8 @@ namespace Mongoose
  * and mapped to vertex c in the coarse graph. Likewise, G->invmatchmap is
  * one possible inverse of G->matchmap, so invmatchmap[c] = a or
  * invmatchmap[c] = b if a coarsened vertex c represents the matching of
- * vertices a and b in the refined graph.
+ * vertices a and b in the refined graph. If G->keepSides is set, the coarse
+ * graph also inherits the partition of G, and likewise G->crossSides.
  *
  * @code
  * Graph coarsened_graph = coarsen(large_graph, options);
@@ -52,7 +55,8 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     (void)options; // Unused variable
 
-    Logger::tic(CoarseningTiming);
+    TraceSpan span("Coarsening", graph->clevel);
+    Logger::tic(CoarseningTiming, graph->clevel);
 
     Int cn     = graph->cn;
     Int *Gp    = graph->p;
@@ -136,6 +140,7 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
                 Int cp = htable[toCoarsened];
                 if (cp < ps) /* Hasn't been seen yet this column */
                 {
+                    MONGOOSE_COUNT(CoarsenHashMissOp);
                     htable[toCoarsened] = munch;
                     Ci[munch]           = toCoarsened;
                     Cx[munch]           = edgeWeight;
@@ -145,6 +150,7 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
                  * sum the edge weights here. */
                 else
                 {
+                    MONGOOSE_COUNT(CoarsenHashHitOp);
                     Cx[cp] += edgeWeight;
                 }
             }
@@ -153,6 +159,12 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
         /* Save the vertex weight. */
         Cw[k] = vertexWeight;
 
+        /* The matched vertices share a side, which the coarse vertex keeps. */
+        if (graph->keepSides)
+            coarseGraph->partition[k] = graph->partition[v[0]];
+        if (graph->crossSides)
+            coarseGraph->crossSides[k] = graph->crossSides[v[0]];
+
         /* Save the sum of edge weights and initialize the gain for k. */
         X += sumEdgeWeights;
         gains[k] = -sumEdgeWeights;
@@ -0,0 +1,451 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Components.cpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Components.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+
+#include <atomic>
+#include <new>
+
+namespace Mongoose
+{
+
+namespace
+{
+
+/* Below this many edges per thread the union-find is run serially. */
+const Int MinParallelEdges = 1 << 16;
+
+/* Every vertex points at a vertex with a lower or equal index, and a root
+ * points at itself, so the root of each tree is its lowest numbered vertex.
+ * Since pointers only ever decrease, concurrent updates cannot form a cycle. */
+Int findRoot(std::atomic<Int> *parent, Int v)
+{
+    while (true)
+    {
+        Int p = parent[v].load();
+        if (p == v)
+            return v;
+        Int gp = parent[p].load();
+        if (gp != p)
+        {
+            // Path halving; losing the race to another thread is harmless
+            parent[v].compare_exchange_weak(p, gp);
+        }
+        v = gp;
+    }
+}
+
+void unite(std::atomic<Int> *parent, Int a, Int b)
+{
+    while (true)
+    {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+
+        // Hook the higher root under the lower one, unless a has meanwhile
+        // stopped being a root
+        Int expected = a;
+        if (parent[a].compare_exchange_strong(expected, b))
+            return;
+    }
+}
+
+/* Split the vertices into ranges with about the same number of edges. */
+void splitVertices(const Graph *graph, size_t numThreads,
+                   std::vector<Int> &split)
+{
+    split.resize(numThreads + 1);
+    split[0]          = 0;
+    split[numThreads] = graph->n;
+    for (size_t t = 1; t < numThreads; t++)
+    {
+        Int target = static_cast<Int>(graph->nz * t / numThreads);
+        split[t]   = std::lower_bound(graph->p, graph->p + graph->n, target)
+                   - graph->p;
+        split[t]   = std::max(split[t], split[t - 1]);
+    }
+}
+
+double *componentWeights(const Graph *graph, const Int *component,
+                         Int numComponents)
+{
+    double *weight = (double *)SuiteSparse_calloc(
+        static_cast<size_t>(numComponents), sizeof(double));
+    if (!weight)
+        return NULL;
+    for (Int k = 0; k < graph->n; k++)
+        weight[component[k]] += (graph->w) ? graph->w[k] : 1;
+    return weight;
+}
+
+Int heaviestComponent(const double *weight, Int numComponents)
+{
+    Int best = 0;
+    for (Int c = 1; c < numComponents; c++)
+    {
+        if (weight[c] > weight[best])
+            best = c;
+    }
+    return best;
+}
+
+EdgeCut *edgeCutOfLargest(const Graph *graph, const Int *component,
+                          Int numComponents, const EdgeCut_Options *options)
+{
+    double *weight = componentWeights(graph, component, numComponents);
+    Int *vertex_map
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(graph->n), sizeof(Int));
+    if (!weight || !vertex_map)
+    {
+        SuiteSparse_free(weight);
+        SuiteSparse_free(vertex_map);
+        return NULL;
+    }
+
+    Int largest = heaviestComponent(weight, numComponents);
+    SuiteSparse_free(weight);
+
+    Graph *subgraph = extractComponent(graph, component, largest, vertex_map);
+    EdgeCut *result = (subgraph) ? edge_cut(subgraph, options) : NULL;
+    if (subgraph)
+        subgraph->~Graph();
+    if (!result)
+    {
+        SuiteSparse_free(vertex_map);
+        return NULL;
+    }
+
+    LogInfo("Partitioned the largest of " << numComponents << " components ("
+                                          << result->n << " of " << graph->n
+                                          << " vertices)\n");
+    result->vertex_map = vertex_map;
+    return result;
+}
+
+/* Pack whole components into the two parts, largest first, each into the
+ * part with the most room left. A component that fits in neither part is cut
+ * so that it fills the roomier part exactly. The remaining components then
+ * weigh just enough to fill the other part, and the cut is as lopsided as
+ * the balance allows, which is usually the cheapest cut. */
+EdgeCut *edgeCutOfPacking(const Graph *graph, const Int *component,
+                          Int numComponents, EdgeCut_Options *options)
+{
+    Int n          = graph->n;
+    double *weight = componentWeights(graph, component, numComponents);
+    Int *size = (Int *)SuiteSparse_calloc(static_cast<size_t>(numComponents),
+                                          sizeof(Int));
+    Int *order = (Int *)SuiteSparse_malloc(static_cast<size_t>(numComponents),
+                                           sizeof(Int));
+    Int *side  = (Int *)SuiteSparse_malloc(static_cast<size_t>(numComponents),
+                                          sizeof(Int));
+    Int *vertex_map
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    EdgeCut *result = (EdgeCut *)SuiteSparse_malloc(1, sizeof(EdgeCut));
+    bool *partition
+        = (bool *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(bool));
+
+    bool ok = (weight && size && order && side && vertex_map && result
+               && partition);
+    if (ok)
+    {
+        for (Int k = 0; k < n; k++)
+            size[component[k]]++;
+        for (Int c = 0; c < numComponents; c++)
+            order[c] = c;
+        std::sort(order, order + numComponents, [&](Int a, Int b) {
+            return (weight[a] > weight[b])
+                   || (weight[a] == weight[b] && a < b);
+        });
+
+        double W           = 0;
+        for (Int c = 0; c < numComponents; c++)
+            W += weight[c];
+        double targetSplit = options->target_split;
+        double room[2]     = { targetSplit * W, (1 - targetSplit) * W };
+        double slack       = options->soft_split_tolerance * W;
+
+        for (Int k = 0; k < numComponents && ok; k++)
+        {
+            Int c        = order[k];
+            Int s        = (room[0] >= room[1]) ? 0 : 1;
+            double share = room[s] / weight[c];
+            double split = std::min(share, 1 - share);
+
+            if (weight[c] <= room[s] + slack || size[c] < 2 || split <= 0)
+            {
+                side[c] = s;
+                room[s] -= weight[c];
+                continue;
+            }
+
+            Graph *subgraph
+                = extractComponent(graph, component, c, vertex_map);
+            options->target_split = split;
+            EdgeCut *cut = (subgraph) ? edge_cut(subgraph, options) : NULL;
+            if (subgraph)
+                subgraph->~Graph();
+            if (!cut)
+            {
+                ok = false;
+                break;
+            }
+
+            // Put whichever side of the cut is nearer the room into part s
+            bool flip = fabs(cut->w1 - room[s]) < fabs(cut->w0 - room[s]);
+            if (s == 1)
+                flip = !flip;
+            for (Int v = 0; v < cut->n; v++)
+                partition[vertex_map[v]] = (cut->partition[v] != flip);
+            room[0] -= (flip) ? cut->w1 : cut->w0;
+            room[1] -= (flip) ? cut->w0 : cut->w1;
+            side[c] = -1;
+            cut->~EdgeCut();
+        }
+        options->target_split = targetSplit;
+    }
+
+    if (ok)
+    {
+        for (Int k = 0; k < n; k++)
+        {
+            if (side[component[k]] >= 0)
+                partition[k] = (side[component[k]] == 1);
+        }
+
+        double W[2]    = { 0, 0 };
+        double cutCost = 0;
+        Int cutSize    = 0;
+        for (Int k = 0; k < n; k++)
+        {
+            W[partition[k]] += (graph->w) ? graph->w[k] : 1;
+            for (Int p = graph->p[k]; p < graph->p[k + 1]; p++)
+            {
+                if (partition[k] != partition[graph->i[p]])
+                {
+                    cutCost += (graph->x) ? graph->x[p] : 1;
+                    cutSize++;
+                }
+            }
+        }
+
+        result->partition = partition;
+        result->n         = n;
+        result->vertex_map = NULL;
+        result->cut_cost  = cutCost / 2;
+        result->cut_size  = cutSize / 2;
+        result->w0        = W[0];
+        result->w1        = W[1];
+        result->imbalance = fabs(options->target_split
+                                 - std::min(W[0], W[1]) / (W[0] + W[1]));
+        result->num_levels  = 0;
+        result->level_stats = NULL;
+
+        LogInfo("Packed " << numComponents << " components into an edge cut\n");
+    }
+    else
+    {
+        SuiteSparse_free(partition);
+        SuiteSparse_free(result);
+        result = NULL;
+    }
+
+    SuiteSparse_free(weight);
+    SuiteSparse_free(size);
+    SuiteSparse_free(order);
+    SuiteSparse_free(side);
+    SuiteSparse_free(vertex_map);
+
+    return result;
+}
+
+} // end anonymous namespace
+
+Int connected_components(const Graph *graph, Int *component)
+{
+    if (!graph || !component)
+        return -1;
+
+    Int n   = graph->n;
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    std::atomic<Int> *parent = (std::atomic<Int> *)SuiteSparse_malloc(
+        static_cast<size_t>(n), sizeof(std::atomic<Int>));
+    if (!parent)
+        return -1;
+    for (Int k = 0; k < n; k++)
+        new (&parent[k]) std::atomic<Int>(k);
+
+    size_t numThreads = parallelThreads(graph->nz, MinParallelEdges);
+    std::vector<Int> split;
+    splitVertices(graph, numThreads, split);
+
+    runThreads(numThreads, [&](size_t t) {
+        for (Int k = split[t]; k < split[t + 1]; k++)
+        {
+            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+            {
+                if (Gi[p] != k)
+                    unite(parent, Gi[p], k);
+            }
+        }
+    });
+    runThreads(numThreads, [&](size_t t) {
+        for (Int k = split[t]; k < split[t + 1]; k++)
+            component[k] = findRoot(parent, k);
+    });
+    SuiteSparse_free(parent);
+
+    // Each root is the lowest vertex of its component, so it is numbered
+    // before any other vertex refers to it.
+    Int numComponents = 0;
+    for (Int k = 0; k < n; k++)
+    {
+        component[k] = (component[k] == k) ? numComponents++
+                                           : component[component[k]];
+    }
+
+    return numComponents;
+}
+
+Graph *extractComponent(const Graph *graph, const Int *component, Int label,
+                        Int *vertex_map)
+{
+    Int n   = graph->n;
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    Int *local = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    if (!local)
+        return NULL;
+
+    Int cn = 0, cnz = 0;
+    for (Int k = 0; k < n; k++)
+    {
+        if (component[k] == label)
+        {
+            local[k] = cn++;
+            cnz += Gp[k + 1] - Gp[k];
+        }
+    }
+
+    Graph *C = Graph::create(cn, cnz);
+    if (C && graph->x)
+        C->x = (double *)SuiteSparse_malloc(static_cast<size_t>(cnz),
+                                            sizeof(double));
+    if (C && graph->w)
+        C->w = (double *)SuiteSparse_malloc(static_cast<size_t>(cn),
+                                            sizeof(double));
+    if (!C || (graph->x && !C->x) || (graph->w && !C->w))
+    {
+        SuiteSparse_free(local);
+        if (C)
+            C->~Graph();
+        return NULL;
+    }
+
+    Int nz = 0;
+    for (Int k = 0; k < n; k++)
+    {
+        if (component[k] != label)
+            continue;
+        Int v   = local[k];
+        C->p[v] = nz;
+        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        {
+            C->i[nz] = local[Gi[p]];
+            if (C->x)
+                C->x[nz] = graph->x[p];
+            nz++;
+        }
+        if (C->w)
+            C->w[v] = graph->w[k];
+        if (vertex_map)
+            vertex_map[v] = k;
+    }
+    C->p[cn] = nz;
+
+    SuiteSparse_free(local);
+    return C;
+}
+
+Graph *largest_component(const Graph *graph, Int *vertex_map)
+{
+    if (!graph)
+        return NULL;
+
+    Int *component = (Int *)SuiteSparse_malloc(static_cast<size_t>(graph->n),
+                                               sizeof(Int));
+    if (!component)
+        return NULL;
+
+    Graph *largest    = NULL;
+    Int numComponents = connected_components(graph, component);
+    double *weight    = (numComponents >= 0)
+                         ? componentWeights(graph, component, numComponents)
+                         : NULL;
+    if (weight)
+    {
+        largest = extractComponent(graph, component,
+                                   heaviestComponent(weight, numComponents),
+                                   vertex_map);
+    }
+
+    SuiteSparse_free(weight);
+    SuiteSparse_free(component);
+    return largest;
+}
+
+EdgeCut *edgeCutByComponents(const Graph *graph,
+                             const EdgeCut_Options *options)
+{
+    Int *component = (Int *)SuiteSparse_malloc(static_cast<size_t>(graph->n),
+                                               sizeof(Int));
+    EdgeCut_Options *componentOptions = EdgeCut_Options::create();
+    if (!component || !componentOptions)
+    {
+        SuiteSparse_free(component);
+        if (componentOptions)
+            componentOptions->~EdgeCut_Options();
+        return NULL;
+    }
+
+    // Each component is partitioned as a whole
+    *componentOptions                    = *options;
+    componentOptions->component_strategy = Components_Together;
+
+    EdgeCut *result   = NULL;
+    Int numComponents = connected_components(graph, component);
+    if (numComponents == 1 || graph->n == 0)
+    {
+        result = edge_cut(graph, componentOptions);
+    }
+    else if (numComponents > 1)
+    {
+        result = (options->component_strategy == Components_Largest)
+                     ? edgeCutOfLargest(graph, component, numComponents,
+                                        componentOptions)
+                     : edgeCutOfPacking(graph, component, numComponents,
+                                        componentOptions);
+    }
+
+    SuiteSparse_free(component);
+    componentOptions->~EdgeCut_Options();
+    return result;
+}
+
+} // end namespace Mongoose
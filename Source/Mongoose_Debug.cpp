@@ -60,7 +60,9 @@ void print(Graph *G)
         ASSERT(0);                                                             \
     }
 
-void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool check_b,
+template <typename Float>
+void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDeltaT<Float> *QP,
+                bool check_b,
                 Int nFreeSet, // use this instead of QP->nFreeSet
                 double b      // use this instead of QP->b
 )
@@ -79,7 +81,7 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
     /* FreeSet_status [i] = +1, -1, or 0 if x_i = 1, 0, or 0 < x_i < 1*/
     //---
 
-    double *x = QP->x; /* current estimate of solution */
+    Float *x = QP->x; /* current estimate of solution */
 
     /* problem specification */
     Int n      = G->n; /* problem dimension */
@@ -90,8 +92,8 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
 
     double lo    = QP->lo;
     double hi    = QP->hi;
-    double *D    = QP->D;        /* diagonal of quadratic */
-    double *grad = QP->gradient; /* gradient at current x */
+    Float *D     = QP->D;        /* diagonal of quadratic */
+    Float *grad  = QP->gradient; /* gradient at current x */
     double tol   = std::max(log10(O->gradproj_tolerance * G->worstCaseRatio),
                           O->gradproj_tolerance);
 
@@ -320,8 +322,9 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
 // FreeSet_dump
 //------------------------------------------------------------------------------
 
+template <typename Float>
 void FreeSet_dump(const char *where, Int n, Int *FreeSet_list, Int nFreeSet,
-                  Int *FreeSet_status, Int verbose, double *x)
+                  Int *FreeSet_status, Int verbose, Float *x)
 {
     Int death = 0;
 
@@ -392,6 +395,16 @@ void FreeSet_dump(const char *where, Int n, Int *FreeSet_list, Int nFreeSet,
     }
     PR(("bye\n"));
 }
+
+/* single and double precision instances */
+template void QPcheckCom<double>(EdgeCutProblem *, const EdgeCut_Options *,
+                                 QPDeltaT<double> *, bool, Int, double);
+template void QPcheckCom<float>(EdgeCutProblem *, const EdgeCut_Options *,
+                                QPDeltaT<float> *, bool, Int, double);
+template void FreeSet_dump<double>(const char *, Int, Int *, Int, Int *, Int,
+                                   double *);
+template void FreeSet_dump<float>(const char *, Int, Int *, Int, Int *, Int,
+                                  float *);
 #endif
 
 } // end namespace Mongoose
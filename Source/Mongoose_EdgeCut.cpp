@@ -11,12 +11,15 @@
 
 #include "Mongoose_EdgeCut.hpp"
 #include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_BoundaryHeap.hpp"
 #include "Mongoose_Coarsening.hpp"
+#include "Mongoose_Components.hpp"
+#include "Mongoose_Evolution.hpp"
 #include "Mongoose_GuessCut.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
-#include "Mongoose_Random.hpp"
 #include "Mongoose_Refinement.hpp"
+#include "Mongoose_Trace.hpp"
 #include "Mongoose_Waterdance.hpp"
 
 #include <algorithm>
@@ -30,6 +33,8 @@ void cleanup(EdgeCutProblem *graph);
 EdgeCut::~EdgeCut()
 {
     SuiteSparse_free(partition);
+    SuiteSparse_free(vertex_map);
+    SuiteSparse_free(level_stats);
     SuiteSparse_free(this);
 }
 
@@ -54,11 +59,15 @@ EdgeCut *edge_cut(const Graph *graph, const EdgeCut_Options *options)
     if (!optionsAreValid(options))
         return NULL;
 
-    setRandomSeed(options->random_seed);
-
     if (!graph)
         return NULL;
 
+    TraceSpan span("EdgeCut");
+
+    // Split the graph into its connected components if requested
+    if (options->component_strategy != Components_Together)
+        return edgeCutByComponents(graph, options);
+
     // Create an EdgeCutProblem
     EdgeCutProblem *problem = EdgeCutProblem::create(graph);
 
@@ -78,23 +87,52 @@ EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options)
     if (!optionsAreValid(options))
         return NULL;
 
-    setRandomSeed(options->random_seed);
-
     if (!problem)
         return NULL;
 
+    // Evolve a population of edge cuts if requested
+    if (options->use_evolution)
+        return evolveEdgeCut(problem, options);
+
+    if (options->collect_stats && MemoryProfiler::isProfiling())
+        MemoryProfiler::startCall();
+
     /* Finish initialization */
     problem->initialize(options);
 
+    EdgeCutProblem *coarsest = coarsenHierarchy(problem, options);
+    if (!coarsest)
+        return NULL;
+
+    return refineHierarchy(coarsest, options);
+}
+
+EdgeCutProblem *coarsenHierarchy(EdgeCutProblem *problem,
+                                 const EdgeCut_Options *options)
+{
     /* Keep track of what the current graph is at any stage */
     EdgeCutProblem *current = problem;
 
     /* If we need to coarsen the graph, do the coarsening. */
     while (current->n >= options->coarsen_limit)
     {
+        int64_t start = (options->collect_stats) ? Trace::now() : 0;
         match(current, options);
+        int64_t matched = (options->collect_stats) ? Trace::now() : 0;
+
+        /* Matching within the sides of a partition can stall. */
+        if (current->keepSides && current->cn == current->n)
+            break;
+
         EdgeCutProblem *next = coarsen(current, options);
 
+        if (options->collect_stats)
+        {
+            EdgeCut_LevelStats &stats = current->stats;
+            stats.matching_time       = (matched - start) / 1e9;
+            stats.coarsening_time     = (Trace::now() - matched) / 1e9;
+        }
+
         /* If we ran out of memory during coarsening, unwind the stack. */
         if (!next)
         {
@@ -110,47 +148,205 @@ EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options)
         current = next;
     }
 
+    return current;
+}
+
+/* Free every level coarser than the finest one, starting from current. */
+static void freeCoarseLevels(EdgeCutProblem *current)
+{
+    while (current->parent != NULL)
+    {
+        EdgeCutProblem *next = current->parent;
+        current->~EdgeCutProblem();
+        current = next;
+    }
+}
+
+bool multilevelCycle(EdgeCutProblem *top, const EdgeCut_Options *options,
+                     CycleType cycleType)
+{
+    TraceSpan span("Cycle", top->clevel);
+
+    Int n       = top->n;
+    bool *saved = (bool *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                             sizeof(bool));
+    if (!saved)
+        return false;
+    std::copy(top->partition, top->partition + n, saved);
+    double savedCost = top->heuCost;
+
+    /* Refine expects empty boundary heaps on the level it refines onto. */
+    bhClear(top);
+    top->clearMatching();
+    bool keepSides = top->keepSides;
+    top->keepSides = true;
+
+    EdgeCutProblem *current = coarsenHierarchy(top, options);
+    if (current)
+    {
+        bhLoad(current, options);
+        waterdance(current, options);
+        while (current != top)
+        {
+            current = refine(current, options);
+            waterdance(current, options);
+            if (cycleType == Cycle_F && current != top)
+                multilevelCycle(current, options, Cycle_V);
+        }
+    }
+    top->keepSides = keepSides;
+
+    if (!current || top->heuCost > savedCost)
+    {
+        std::copy(saved, saved + n, top->partition);
+        top->qpSolution = (double *)SuiteSparse_free(top->qpSolution);
+        if (current)
+            bhClear(top);
+        bhLoad(top, options);
+    }
+
+    SuiteSparse_free(saved);
+    return (current != NULL);
+}
+
+/* Run the cycles after the first one until they stop paying off, or until
+ * num_cycles or the time budget is reached. */
+static void runCycles(EdgeCutProblem *graph, const EdgeCut_Options *options)
+{
+    int64_t start = Trace::now();
+    for (Int c = 1; c < options->num_cycles; c++)
+    {
+        if (options->cycle_time_budget > 0
+            && (Trace::now() - start) / 1e9 >= options->cycle_time_budget)
+        {
+            break;
+        }
+
+        double before = graph->heuCost;
+        if (!multilevelCycle(graph, options, options->cycle_type))
+            break;
+
+        if (before <= 0
+            || (before - graph->heuCost) / before
+                   < options->cycle_min_improvement)
+        {
+            break;
+        }
+    }
+}
+
+/* Copy the statistics of a level before refine frees it, and count its
+ * matches. */
+static void saveLevelStats(EdgeCutProblem *level, EdgeCut_LevelStats *stats)
+{
+    if (!stats)
+        return;
+
+    EdgeCut_LevelStats &saved = stats[level->clevel];
+    saved                     = level->stats;
+    saved.n                   = level->n;
+    saved.nz                  = level->nz;
+
+    /* Every level but the coarsest was matched. */
+    if (level->cn > 0)
+    {
+        for (Int k = 0; k < level->n; k++)
+            saved.match_count[level->matchtype[k]]++;
+    }
+
+    /* Allocations made by all phases at this level */
+    if (MemoryProfiler::isProfiling())
+    {
+        MemoryCounts memory;
+        MemoryProfiler::getLevelCounts(static_cast<int>(level->clevel),
+                                       memory);
+        saved.allocations     = memory.allocations;
+        saved.allocated_bytes = memory.bytes;
+        saved.peak_bytes      = memory.peakBytes;
+    }
+}
+
+EdgeCut *refineHierarchy(EdgeCutProblem *coarsest,
+                         const EdgeCut_Options *options)
+{
+    EdgeCutProblem *current = coarsest;
+    Int numLevels           = coarsest->clevel + 1;
+
+    EdgeCut_LevelStats *stats = NULL;
+    if (options->collect_stats)
+    {
+        stats = (EdgeCut_LevelStats *)SuiteSparse_calloc(
+            static_cast<size_t>(numLevels), sizeof(EdgeCut_LevelStats));
+        if (!stats)
+        {
+            LogError("Error: Ran out of memory in Mongoose::edge_cut\n");
+            freeCoarseLevels(current);
+            return NULL;
+        }
+    }
+
     /*
      * Generate a guess cut and do FM refinement.
      * On failure, unwind the stack.
      */
+    int64_t start = (stats) ? Trace::now() : 0;
     if (!guessCut(current, options))
     {
-        while (current != problem)
-        {
-            EdgeCutProblem *next = current->parent;
-            current->~EdgeCutProblem();
-            current = next;
-        }
+        freeCoarseLevels(current);
+        SuiteSparse_free(stats);
         return NULL;
     }
+    if (stats)
+        current->stats.guess_cut_time = (Trace::now() - start) / 1e9;
 
     /*
      * Refine the guess cut back to the beginning.
      */
     while (current->parent != NULL)
     {
+        saveLevelStats(current, stats);
+        start   = (stats) ? Trace::now() : 0;
         current = refine(current, options);
+        if (stats)
+            current->stats.refinement_time = (Trace::now() - start) / 1e9;
         waterdance(current, options);
     }
 
+    /* The statistics are those of the first cycle. */
+    saveLevelStats(current, stats);
+    runCycles(current, options);
     cleanup(current);
 
+    if (stats)
+    {
+        for (Int k = 0; k < numLevels; k++)
+        {
+            stats[k].contraction
+                = (k + 1 < numLevels && stats[k].n > 0)
+                      ? static_cast<double>(stats[k + 1].n) / stats[k].n
+                      : 1.0;
+        }
+    }
+
     EdgeCut *result = (EdgeCut*)SuiteSparse_malloc(1, sizeof(EdgeCut));
 
     if (!result)
     {
+        SuiteSparse_free(stats);
         return NULL;
     }
 
     result->partition = current->partition;
     current->partition = NULL; // Unlink pointer
     result->n         = current->n;
+    result->vertex_map = NULL;
     result->cut_cost  = current->cutCost;
     result->cut_size  = current->cutSize;
     result->w0        = current->W0;
     result->w1        = current->W1;
     result->imbalance = current->imbalance;
+    result->num_levels  = (stats) ? numLevels : 0;
+    result->level_stats = stats;
 
     return result;
 }
@@ -163,6 +359,14 @@ bool optionsAreValid(const EdgeCut_Options *options)
         return (false);
     }
 
+    if (options->component_strategy < Components_Together
+        || options->component_strategy > Components_BinPack)
+    {
+        LogError("Fatal Error: options->component_strategy is not a valid "
+                 "ComponentStrategy.");
+        return (false);
+    }
+
     if (options->coarsen_limit < 1)
     {
         LogError("Fatal Error: options->coarsen_limit cannot be less than one.");
@@ -176,12 +380,88 @@ bool optionsAreValid(const EdgeCut_Options *options)
         return (false);
     }
 
+    if (options->num_cycles < 1)
+    {
+        LogError("Fatal Error: options->num_cycles cannot be less than one.");
+        return (false);
+    }
+
+    if (options->cycle_type < Cycle_V || options->cycle_type > Cycle_F)
+    {
+        LogError("Fatal Error: options->cycle_type is not a valid CycleType.");
+        return (false);
+    }
+
+    if (options->cycle_min_improvement < 0)
+    {
+        LogError("Fatal Error: options->cycle_min_improvement cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
+    if (options->cycle_time_budget < 0)
+    {
+        LogError("Fatal Error: options->cycle_time_budget cannot be less than "
+                 "zero.");
+        return (false);
+    }
+
+    if (options->evolution_population < 2)
+    {
+        LogError("Fatal Error: options->evolution_population cannot be less "
+                 "than two.");
+        return (false);
+    }
+
+    if (options->evolution_generations < 0)
+    {
+        LogError("Fatal Error: options->evolution_generations cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
+    if (options->evolution_mutation_rate < 0
+        || options->evolution_mutation_rate > 1)
+    {
+        LogError("Fatal Error: options->evolution_mutation_rate must be in the "
+                 "range [0, 1].");
+        return (false);
+    }
+
+    if (options->evolution_time_budget < 0)
+    {
+        LogError("Fatal Error: options->evolution_time_budget cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
     if (options->num_dances < 0)
     {
         LogError("Fatal Error: options->num_dances cannot be less than zero.");
         return (false);
     }
 
+    if (options->waterdance_min_payoff < 0)
+    {
+        LogError("Fatal Error: options->waterdance_min_payoff cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
+    if (options->waterdance_max_dances < 0)
+    {
+        LogError("Fatal Error: options->waterdance_max_dances cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
+    if (options->waterdance_time_budget < 0)
+    {
+        LogError("Fatal Error: options->waterdance_time_budget cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
     if (options->FM_search_depth < 0)
     {
         LogError(
@@ -25,6 +25,8 @@ EdgeCut_Options *EdgeCut_Options::create()
     {
         ret->random_seed = 0;
 
+        ret->component_strategy = Components_Together;
+
         ret->coarsen_limit        = 64;
         ret->matching_strategy    = HEMSR;
         ret->do_community_matching = false;
@@ -32,7 +34,22 @@ EdgeCut_Options *EdgeCut_Options::create()
 
         ret->initial_cut_type = InitialEdgeCut_Random;
 
-        ret->num_dances = 1;
+        ret->num_cycles            = 1;
+        ret->cycle_type            = Cycle_V;
+        ret->cycle_min_improvement = 0.001;
+        ret->cycle_time_budget     = 0;
+
+        ret->use_evolution           = false;
+        ret->evolution_population    = 8;
+        ret->evolution_generations   = 16;
+        ret->evolution_mutation_rate = 0.1;
+        ret->evolution_time_budget   = 0;
+
+        ret->num_dances              = 1;
+        ret->use_adaptive_waterdance = false;
+        ret->waterdance_min_payoff   = 0.01;
+        ret->waterdance_max_dances   = 4;
+        ret->waterdance_time_budget  = 0;
 
         ret->use_FM               = true;
         ret->FM_search_depth       = 50;
@@ -42,9 +59,13 @@ EdgeCut_Options *EdgeCut_Options::create()
         ret->use_QP_gradproj          = true;
         ret->gradproj_tolerance      = 0.001;
         ret->gradproj_iteration_limit = 50;
+        ret->use_QP_single_precision  = false;
+        ret->use_QP_prolongation      = false;
 
         ret->target_split        = 0.5;
         ret->soft_split_tolerance = 0;
+
+        ret->collect_stats = false;
     }
 
     return ret;
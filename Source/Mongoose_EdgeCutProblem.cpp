@@ -12,6 +12,7 @@
 #include "Mongoose_EdgeCutProblem.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <new>
 
 namespace Mongoose
@@ -35,6 +36,7 @@ EdgeCutProblem::EdgeCutProblem()
     bhIndex        = NULL;
     bhHeap[0] = bhHeap[1] = NULL;
     bhSize[0] = bhSize[1] = 0;
+    qpSolution = NULL;
 
     heuCost   = 0.0;
     cutCost   = 0.0;
@@ -49,6 +51,15 @@ EdgeCutProblem::EdgeCutProblem()
     matchmap    = NULL;
     invmatchmap = NULL;
     matchtype   = NULL;
+    keepSides   = false;
+    crossSides  = NULL;
+
+    fmPayoff  = 0.0;
+    qpPayoff  = 0.0;
+    qpProbe   = true;
+    danceTime = 0.0;
+
+    memset(&stats, 0, sizeof(stats));
 
     markArray = NULL;
     markValue = 1;
@@ -121,6 +132,8 @@ EdgeCutProblem *EdgeCutProblem::create(const Int _n, const Int _nz, Int *_p,
     graph->markArray   = (Int *)SuiteSparse_calloc(n, sizeof(Int));
     graph->markValue   = 1;
     graph->singleton   = -1;
+    graph->keepSides   = false;
+    graph->crossSides  = NULL;
     if (!graph->matching || !graph->matchmap || !graph->invmatchmap
         || !graph->markArray || !graph->matchtype)
     {
@@ -157,9 +170,21 @@ EdgeCutProblem *EdgeCutProblem::create(EdgeCutProblem *_parent)
         return NULL;
     }
 
-    graph->W      = _parent->W;
-    graph->parent = _parent;
-    graph->clevel = graph->parent->clevel + 1;
+    if (_parent->crossSides)
+    {
+        graph->crossSides = (bool *)SuiteSparse_malloc(_parent->cn,
+                                                       sizeof(bool));
+        if (!graph->crossSides)
+        {
+            graph->~EdgeCutProblem();
+            return NULL;
+        }
+    }
+
+    graph->W         = _parent->W;
+    graph->parent    = _parent;
+    graph->clevel    = graph->parent->clevel + 1;
+    graph->keepSides = _parent->keepSides;
 
     return graph;
 }
@@ -177,10 +202,12 @@ EdgeCutProblem::~EdgeCutProblem()
     bhIndex        = (Int *)SuiteSparse_free(bhIndex);
     bhHeap[0]      = (Int *)SuiteSparse_free(bhHeap[0]);
     bhHeap[1]      = (Int *)SuiteSparse_free(bhHeap[1]);
+    qpSolution     = (double *)SuiteSparse_free(qpSolution);
     matching       = (Int *)SuiteSparse_free(matching);
     matchmap       = (Int *)SuiteSparse_free(matchmap);
     invmatchmap    = (Int *)SuiteSparse_free(invmatchmap);
     matchtype      = (Int *)SuiteSparse_free(matchtype);
+    crossSides     = (bool *)SuiteSparse_free(crossSides);
 
     markArray = (Int *)SuiteSparse_free(markArray);
 
@@ -202,6 +229,7 @@ void EdgeCutProblem::initialize(const EdgeCut_Options *options)
         H = 0.0;
 
         bhSize[0] = bhSize[1] = 0;
+        qpSolution = (double *)SuiteSparse_free(qpSolution);
 
         heuCost   = 0.0;
         cutCost   = 0.0;
@@ -210,14 +238,21 @@ void EdgeCutProblem::initialize(const EdgeCut_Options *options)
         imbalance = 0.0;
 
         clevel = 0;
-        cn     = 0;
         for (Int k = 0; k < n; k++)
         {
             externalDegree[k] = 0;
             bhIndex[k]        = 0;
-            matching[k]       = 0;
         }
-        singleton = -1;
+        clearMatching();
+        keepSides  = false;
+        crossSides = (bool *)SuiteSparse_free(crossSides);
+
+        fmPayoff  = 0.0;
+        qpPayoff  = 0.0;
+        qpProbe   = true;
+        danceTime = 0.0;
+
+        memset(&stats, 0, sizeof(stats));
 
         clearMarkArray();
     }
@@ -261,6 +296,17 @@ void EdgeCutProblem::initialize(const EdgeCut_Options *options)
     initialized = true;
 }
 
+/* Forget the matching, so that the graph can be matched again. */
+void EdgeCutProblem::clearMatching()
+{
+    cn = 0;
+    for (Int k = 0; k < n; k++)
+    {
+        matching[k] = 0;
+    }
+    singleton = -1;
+}
+
 void EdgeCutProblem::clearMarkArray()
 {
     markValue += 1;
@@ -0,0 +1,378 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Evolution.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Evolution.hpp"
+#include "Mongoose_BoundaryHeap.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <algorithm>
+
+namespace Mongoose
+{
+
+void cleanup(EdgeCutProblem *graph);
+
+/* Logger times are kept per thread, so the phases that a founder or an
+ * offspring times on a worker thread are taken off that thread, and charged
+ * to the thread that called evolveEdgeCut once the generation is made. */
+static const int NumTimingTypes = IOTiming + 1;
+
+/* Note the times of the thread about to make the individual of a slot. */
+static void startSlotTimes(float *spent)
+{
+    for (int t = 0; t < NumTimingTypes; t++)
+        spent[t] = Logger::getTime(static_cast<TimingType>(t));
+}
+
+/* Take the times spent on the individual of a slot off the thread. */
+static void stopSlotTimes(float *spent)
+{
+    for (int t = 0; t < NumTimingTypes; t++)
+    {
+        TimingType timingType = static_cast<TimingType>(t);
+        spent[t]              = Logger::getTime(timingType) - spent[t];
+        Logger::addTime(timingType, -spent[t]);
+    }
+}
+
+/* Charge the times spent on every slot to the calling thread. */
+static void chargeSlotTimes(const float *spent, Int size)
+{
+    for (Int s = 0; s < size; s++)
+    {
+        for (int t = 0; t < NumTimingTypes; t++)
+        {
+            Logger::addTime(static_cast<TimingType>(t),
+                            spent[s * NumTimingTypes + t]);
+        }
+    }
+}
+
+/* A member of the population, or an offspring */
+struct Individual
+{
+    bool *partition;
+    double heuCost; /* Cut cost plus balance penalty */
+};
+
+/* A problem of its own on the graph of problem, so that every offspring has
+ * its own partition, boundary heaps and coarse levels. */
+static EdgeCutProblem *workspace(EdgeCutProblem *problem,
+                                 const EdgeCut_Options *options)
+{
+    EdgeCutProblem *graph = EdgeCutProblem::create(
+        problem->n, problem->nz, problem->p, problem->i, problem->x,
+        problem->w);
+    if (graph)
+        graph->initialize(options);
+    return graph;
+}
+
+/* Replace the partition of graph, and load its boundary heaps. */
+static void loadPartition(EdgeCutProblem *graph, const bool *partition,
+                          const EdgeCut_Options *options)
+{
+    bhClear(graph);
+    if (partition != graph->partition)
+        std::copy(partition, partition + graph->n, graph->partition);
+    graph->qpSolution = (double *)SuiteSparse_free(graph->qpSolution);
+    bhLoad(graph, options);
+}
+
+/* An ordinary edge cut, from a random seed of its own */
+static bool makeFounder(EdgeCutProblem *problem,
+                        const EdgeCut_Options *options, Int slot,
+                        Individual &founder)
+{
+    EdgeCut_Options *trial = EdgeCut_Options::create();
+    if (!trial)
+        return false;
+    *trial               = *options;
+    trial->random_seed   = options->random_seed + slot;
+    trial->collect_stats = false;
+
+    EdgeCutProblem *graph = workspace(problem, trial);
+    EdgeCutProblem *coarsest
+        = (graph) ? coarsenHierarchy(graph, trial) : NULL;
+    EdgeCut *cut = (coarsest) ? refineHierarchy(coarsest, trial) : NULL;
+    if (cut)
+    {
+        // Take the partition back to compute its cost before cleanup.
+        graph->partition = cut->partition;
+        cut->partition   = NULL;
+        cut->~EdgeCut();
+        loadPartition(graph, graph->partition, trial);
+        std::copy(graph->partition, graph->partition + graph->n,
+                  founder.partition);
+        founder.heuCost = graph->heuCost;
+    }
+
+    if (graph)
+        graph->~EdgeCutProblem();
+    trial->~EdgeCut_Options();
+    return (cut != NULL);
+}
+
+/* The better of two random members of the population */
+static Int tournament(const Individual *population, Int size, uint64_t key,
+                      Int slot, uint64_t draw)
+{
+    Int a = randomIndex(key, static_cast<uint64_t>(slot), draw, size);
+    Int b = randomIndex(key, static_cast<uint64_t>(slot), draw + 1, size);
+    return (population[b].heuCost < population[a].heuCost) ? b : a;
+}
+
+/* Flip about half of the boundary vertices of graph, for a multilevel cycle
+ * to repair. */
+static void perturb(EdgeCutProblem *graph, uint64_t key, Int slot,
+                    const EdgeCut_Options *options)
+{
+    // Draws 0 to 5 of each slot choose its parents.
+    uint64_t draw = 8 + static_cast<uint64_t>(slot);
+    for (Int h = 0; h < 2; h++)
+    {
+        Int *bhHeap = graph->bhHeap[h];
+        for (Int hpos = 0; hpos < graph->bhSize[h]; hpos++)
+        {
+            Int k = bhHeap[hpos];
+            if (randomBits(key, static_cast<uint64_t>(k), draw) & 1)
+                graph->partition[k] = !graph->partition[k];
+        }
+    }
+    loadPartition(graph, graph->partition, options);
+}
+
+/* Make the offspring of one slot of a generation: a mutant of one parent,
+ * or else the combination of two. */
+static bool makeOffspring(EdgeCutProblem *problem,
+                          const EdgeCut_Options *options,
+                          const Individual *population, Int generation,
+                          Int slot, Individual &child)
+{
+    Int size     = options->evolution_population;
+    uint64_t key = randomKey(options->random_seed, generation);
+    bool mutate  = randomUniform(key, static_cast<uint64_t>(slot))
+                  < options->evolution_mutation_rate;
+
+    Int first  = tournament(population, size, key, slot, 1);
+    Int second = tournament(population, size, key, slot, 3);
+    if (second == first)
+    {
+        second = (first + 1
+                  + randomIndex(key, static_cast<uint64_t>(slot), 5,
+                                size - 1))
+                 % size;
+    }
+    if (population[second].heuCost < population[first].heuCost)
+        std::swap(first, second);
+
+    EdgeCutProblem *graph = workspace(problem, options);
+    if (!graph)
+        return false;
+
+    bool ok = true;
+    if (mutate)
+    {
+        loadPartition(graph, population[first].partition, options);
+        perturb(graph, key, slot, options);
+    }
+    else
+    {
+        // Start from the better parent, and keep the cut of the other one
+        // out of the coarse graphs.
+        graph->crossSides = (bool *)SuiteSparse_malloc(
+            static_cast<size_t>(graph->n), sizeof(bool));
+        ok = (graph->crossSides != NULL);
+        if (ok)
+        {
+            const bool *other = population[second].partition;
+            std::copy(other, other + graph->n, graph->crossSides);
+            loadPartition(graph, population[first].partition, options);
+        }
+    }
+
+    ok = ok && multilevelCycle(graph, options, options->cycle_type);
+    if (ok)
+    {
+        std::copy(graph->partition, graph->partition + graph->n,
+                  child.partition);
+        child.heuCost = graph->heuCost;
+    }
+
+    graph->~EdgeCutProblem();
+    return ok;
+}
+
+/* Whether two partitions make the same cut, with or without their sides
+ * swapped */
+static bool sameCut(const bool *a, const bool *b, Int n)
+{
+    if (n == 0)
+        return true;
+
+    bool swapped = (a[0] != b[0]);
+    for (Int k = 1; k < n; k++)
+    {
+        if ((a[k] != b[k]) != swapped)
+            return false;
+    }
+    return true;
+}
+
+/* Let child replace the worst member of the population if it is better and
+ * not already a member. */
+static void replaceWorst(Individual *population, Int size, Int n,
+                         Individual &child)
+{
+    Int worst = 0;
+    for (Int s = 0; s < size; s++)
+    {
+        if (population[s].heuCost == child.heuCost
+            && sameCut(population[s].partition, child.partition, n))
+            return;
+        if (population[s].heuCost > population[worst].heuCost)
+            worst = s;
+    }
+
+    if (child.heuCost < population[worst].heuCost)
+        std::swap(population[worst], child);
+}
+
+/* Build the edge cut of the best member of the population. */
+static EdgeCut *bestEdgeCut(EdgeCutProblem *problem,
+                            const EdgeCut_Options *options,
+                            const Individual *population, Int size)
+{
+    Int best = 0;
+    for (Int s = 1; s < size; s++)
+    {
+        if (population[s].heuCost < population[best].heuCost)
+            best = s;
+    }
+
+    EdgeCutProblem *graph = workspace(problem, options);
+    EdgeCut *result = (EdgeCut *)SuiteSparse_malloc(1, sizeof(EdgeCut));
+    if (!graph || !result)
+    {
+        if (graph)
+            graph->~EdgeCutProblem();
+        SuiteSparse_free(result);
+        return NULL;
+    }
+
+    loadPartition(graph, population[best].partition, options);
+    cleanup(graph);
+
+    result->partition   = graph->partition;
+    graph->partition    = NULL; // Unlink pointer
+    result->n           = graph->n;
+    result->vertex_map  = NULL;
+    result->cut_cost    = graph->cutCost;
+    result->cut_size    = graph->cutSize;
+    result->w0          = graph->W0;
+    result->w1          = graph->W1;
+    result->imbalance   = graph->imbalance;
+    result->num_levels  = 0;
+    result->level_stats = NULL;
+
+    graph->~EdgeCutProblem();
+    return result;
+}
+
+EdgeCut *evolveEdgeCut(EdgeCutProblem *problem,
+                       const EdgeCut_Options *options)
+{
+    TraceSpan span("Evolution");
+
+    Int n         = problem->n;
+    Int size      = options->evolution_population;
+    int64_t start = Trace::now();
+
+    /* The population, then the offspring of a generation */
+    Individual *individuals = (Individual *)SuiteSparse_calloc(
+        static_cast<size_t>(2 * size), sizeof(Individual));
+    bool *partitions = (bool *)SuiteSparse_malloc(
+        static_cast<size_t>(2 * size * n), sizeof(bool));
+    bool *made = (bool *)SuiteSparse_malloc(static_cast<size_t>(size),
+                                           sizeof(bool));
+    float *spent = (float *)SuiteSparse_malloc(
+        static_cast<size_t>(size * NumTimingTypes), sizeof(float));
+    if (!individuals || !partitions || !made || !spent)
+    {
+        LogError("Error: Ran out of memory in Mongoose::evolveEdgeCut\n");
+        SuiteSparse_free(individuals);
+        SuiteSparse_free(partitions);
+        SuiteSparse_free(made);
+        SuiteSparse_free(spent);
+        return NULL;
+    }
+    for (Int s = 0; s < 2 * size; s++)
+        individuals[s].partition = partitions + s * n;
+    Individual *population = individuals;
+    Individual *offspring  = individuals + size;
+
+    parallelFor(0, size, 1, [&](Int s0, Int s1) {
+        for (Int s = s0; s < s1; s++)
+        {
+            startSlotTimes(spent + s * NumTimingTypes);
+            made[s] = makeFounder(problem, options, s, population[s]);
+            stopSlotTimes(spent + s * NumTimingTypes);
+        }
+    });
+    chargeSlotTimes(spent, size);
+    bool ok = std::all_of(made, made + size, [](bool m) { return m; });
+
+    for (Int generation = 1;
+         ok && generation <= options->evolution_generations; generation++)
+    {
+        if (options->evolution_time_budget > 0
+            && (Trace::now() - start) / 1e9 >= options->evolution_time_budget)
+        {
+            break;
+        }
+
+        parallelFor(0, size, 1, [&](Int s0, Int s1) {
+            for (Int s = s0; s < s1; s++)
+            {
+                startSlotTimes(spent + s * NumTimingTypes);
+                made[s] = makeOffspring(problem, options, population,
+                                        generation, s, offspring[s]);
+                stopSlotTimes(spent + s * NumTimingTypes);
+            }
+        });
+        chargeSlotTimes(spent, size);
+
+        /* Replace in slot order, so that threads do not change the result.
+         * An offspring that ran out of memory is skipped. */
+        for (Int s = 0; s < size; s++)
+        {
+            if (made[s])
+                replaceWorst(population, size, n, offspring[s]);
+        }
+    }
+
+    EdgeCut *result = (ok) ? bestEdgeCut(problem, options, population, size)
+                           : NULL;
+    if (!result)
+        LogError("Error: Ran out of memory in Mongoose::evolveEdgeCut\n");
+
+    SuiteSparse_free(individuals);
+    SuiteSparse_free(partitions);
+    SuiteSparse_free(made);
+    SuiteSparse_free(spent);
+    return result;
+}
+
+} // end namespace Mongoose
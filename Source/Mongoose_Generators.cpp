@@ -0,0 +1,480 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Generators.cpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Generators.hpp"
+#include "Mongoose_CSparse.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_Sanitize.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
+
+namespace Mongoose
+{
+
+namespace
+{
+
+/* Below this many vertices (or edges) per thread a loop is run serially. */
+const Int MinParallelVertices = 1 << 14;
+const Int MinParallelEdges    = 1 << 16;
+
+/* Graphs larger than this are refused rather than overflowing Int. */
+const double MaxGeneratedSize = 4.0e18;
+
+const double Pi = 3.14159265358979323846;
+
+/* Parameters of the random graphs of generate_graph */
+const double SpecAverageDegree = 10;
+const Int SpecEdgeFactor       = 16;
+
+/* Separates the draws of the R-MAT vertex renumbering from its edges. */
+const uint64_t PermutationStream = 0x5851F42D4C957F2DULL;
+
+/**
+ * Build a graph in which vertex v has degree(v) neighbors, written in order
+ * by fill(v, Gi) to Gi[0..degree(v)-1]. Both are called on many vertices at
+ * once, and fill must write the same neighbors that degree counted.
+ */
+template <typename Degree, typename Fill>
+Graph *buildGraph(Int n, const Degree &degree, const Fill &fill)
+{
+    Int *Gp = (Int *)SuiteSparse_malloc(static_cast<size_t>(n + 1),
+                                        sizeof(Int));
+    if (!Gp)
+        return NULL;
+
+    Gp[0] = 0;
+    parallelFor(0, n, MinParallelVertices, [&](Int v0, Int v1) {
+        for (Int v = v0; v < v1; v++)
+            Gp[v + 1] = degree(v);
+    });
+    for (Int v = 0; v < n; v++)
+        Gp[v + 1] += Gp[v];
+
+    Graph *G = Graph::create(n, Gp[n]);
+    if (!G)
+    {
+        SuiteSparse_free(Gp);
+        return NULL;
+    }
+    SuiteSparse_free(G->p);
+    G->p = Gp;
+
+    Int *Gi = G->i;
+    parallelFor(0, n, MinParallelVertices, [&](Int v0, Int v1) {
+        for (Int v = v0; v < v1; v++)
+            fill(v, Gi + Gp[v]);
+    });
+    return G;
+}
+
+/* Build a sanitized, unweighted graph from a triplet matrix that lists each
+ * edge at least once. T is freed. */
+Graph *graphFromEdges(cs *T)
+{
+    cs *A = sanitizeTriplets(T, true, true);
+    if (!A)
+        return NULL;
+
+    Graph *G = Graph::create(A, true);
+    if (!G)
+    {
+        cs_spfree(A);
+        return NULL;
+    }
+    A->p = NULL;
+    A->i = NULL;
+    A->x = NULL;
+    cs_spfree(A);
+    return G;
+}
+
+/* The graph of a 5/7 point (or, if full, 9/27 point) stencil on a grid.
+ * caller names the generator in error messages. */
+Graph *stencilGraph(Int nx, Int ny, Int nz, bool full, const char *caller)
+{
+    if (nx < 1 || ny < 1 || nz < 1
+        || static_cast<double>(nx) * ny * nz > MaxGeneratedSize / 27)
+    {
+        LogError("Error: Grid dimensions must be positive and not too "
+                 "large\n");
+        return NULL;
+    }
+
+    // Offsets in increasing order of dz, dy, dx are in increasing order of
+    // the neighbor's index, so each column comes out sorted.
+    Int offset[26][3];
+    int numOffsets = 0;
+    for (Int dz = -1; dz <= 1; dz++)
+    {
+        for (Int dy = -1; dy <= 1; dy++)
+        {
+            for (Int dx = -1; dx <= 1; dx++)
+            {
+                Int distance = std::abs(dx) + std::abs(dy) + std::abs(dz);
+                if (distance == 0 || (!full && distance != 1))
+                    continue;
+                offset[numOffsets][0] = dx;
+                offset[numOffsets][1] = dy;
+                offset[numOffsets][2] = dz;
+                numOffsets++;
+            }
+        }
+    }
+
+    Int n = nx * ny * nz;
+    auto neighbors = [&](Int v, Int *Gi) -> Int {
+        Int x = v % nx, y = (v / nx) % ny, z = v / (nx * ny);
+        Int count = 0;
+        for (int k = 0; k < numOffsets; k++)
+        {
+            Int ux = x + offset[k][0];
+            Int uy = y + offset[k][1];
+            Int uz = z + offset[k][2];
+            if (ux < 0 || ux >= nx || uy < 0 || uy >= ny || uz < 0
+                || uz >= nz)
+                continue;
+            if (Gi)
+                Gi[count] = ux + nx * (uy + ny * uz);
+            count++;
+        }
+        return count;
+    };
+
+    Graph *G = buildGraph(n, [&](Int v) { return neighbors(v, NULL); },
+                          [&](Int v, Int *Gi) { neighbors(v, Gi); });
+    if (!G)
+        LogError("Error: Ran out of memory in Mongoose::" << caller << "\n");
+    return G;
+}
+
+} // end anonymous namespace
+
+Graph *generate_grid(Int nx, Int ny, Int nz)
+{
+    TraceSpan span("GenerateGraph");
+    return stencilGraph(nx, ny, nz, false, "generate_grid");
+}
+
+Graph *generate_mesh(Int nx, Int ny, Int nz)
+{
+    TraceSpan span("GenerateGraph");
+    return stencilGraph(nx, ny, nz, true, "generate_mesh");
+}
+
+Graph *generate_geometric(Int n, double average_degree, Int dimension,
+                          Int seed)
+{
+    TraceSpan span("GenerateGraph");
+    if (n < 1 || static_cast<double>(n) > MaxGeneratedSize
+        || !(average_degree > 0) || (dimension != 2 && dimension != 3))
+    {
+        LogError("Error: A geometric graph needs n > 0, a positive average "
+                 "degree, and dimension 2 or 3\n");
+        return NULL;
+    }
+
+    // Away from the boundary, a point has n times the volume of a ball of
+    // this radius neighbors on average.
+    double radius = (dimension == 2)
+                        ? std::sqrt(average_degree / (Pi * n))
+                        : std::cbrt(3 * average_degree / (4 * Pi * n));
+
+    // Cells at least as wide as the radius, so that a point's neighbors are
+    // in its own cell or the cells next to it, and no more cells than points.
+    double cellsPerPoint = std::pow(static_cast<double>(n), 1.0 / dimension);
+    Int g = static_cast<Int>(std::min(1 / radius, cellsPerPoint));
+    g     = std::max<Int>(1, g);
+    Int gz         = (dimension == 3) ? g : 1;
+    Int numCells   = g * g * gz;
+    uint64_t useed = static_cast<uint64_t>(seed);
+
+    double *coord = (double *)SuiteSparse_malloc(static_cast<size_t>(3 * n),
+                                                 sizeof(double));
+    Int *cell     = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                          sizeof(Int));
+    Int *cellStart = (Int *)SuiteSparse_calloc(
+        static_cast<size_t>(numCells + 1), sizeof(Int));
+    Int *order = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    if (!coord || !cell || !cellStart || !order)
+    {
+        SuiteSparse_free(coord);
+        SuiteSparse_free(cell);
+        SuiteSparse_free(cellStart);
+        SuiteSparse_free(order);
+        LogError("Error: Ran out of memory in Mongoose::generate_geometric\n");
+        return NULL;
+    }
+
+    parallelFor(0, n, MinParallelVertices, [&](Int v0, Int v1) {
+        for (Int v = v0; v < v1; v++)
+        {
+            Int c[3] = { 0, 0, 0 };
+            for (Int a = 0; a < 3; a++)
+            {
+                coord[3 * v + a]
+                    = (a < dimension) ? randomUniform(useed, v, a) : 0;
+                c[a] = std::min(g - 1,
+                                static_cast<Int>(coord[3 * v + a] * g));
+            }
+            cell[v] = c[0] + g * (c[1] + g * c[2]);
+        }
+    });
+
+    // Sort the points by cell.
+    for (Int v = 0; v < n; v++)
+        cellStart[cell[v] + 1]++;
+    for (Int c = 0; c < numCells; c++)
+        cellStart[c + 1] += cellStart[c];
+    for (Int v = 0; v < n; v++)
+        order[cellStart[cell[v]]++] = v;
+    for (Int c = numCells; c > 0; c--)
+        cellStart[c] = cellStart[c - 1];
+    cellStart[0] = 0;
+
+    double r2      = radius * radius;
+    auto neighbors = [&](Int v, Int *Gi) -> Int {
+        Int cx = cell[v] % g, cy = (cell[v] / g) % g, cz = cell[v] / (g * g);
+        Int count = 0;
+        for (Int z = std::max<Int>(0, cz - 1); z <= std::min(gz - 1, cz + 1);
+             z++)
+        {
+            for (Int y = std::max<Int>(0, cy - 1); y <= std::min(g - 1, cy + 1);
+                 y++)
+            {
+                for (Int x = std::max<Int>(0, cx - 1);
+                     x <= std::min(g - 1, cx + 1); x++)
+                {
+                    Int c = x + g * (y + g * z);
+                    for (Int k = cellStart[c]; k < cellStart[c + 1]; k++)
+                    {
+                        Int u = order[k];
+                        double d0 = coord[3 * u] - coord[3 * v];
+                        double d1 = coord[3 * u + 1] - coord[3 * v + 1];
+                        double d2 = coord[3 * u + 2] - coord[3 * v + 2];
+                        if (u == v || d0 * d0 + d1 * d1 + d2 * d2 >= r2)
+                            continue;
+                        if (Gi)
+                            Gi[count] = u;
+                        count++;
+                    }
+                }
+            }
+        }
+        if (Gi)
+            std::sort(Gi, Gi + count);
+        return count;
+    };
+
+    Graph *G = buildGraph(n, [&](Int v) { return neighbors(v, NULL); },
+                          [&](Int v, Int *Gi) { neighbors(v, Gi); });
+
+    SuiteSparse_free(coord);
+    SuiteSparse_free(cell);
+    SuiteSparse_free(cellStart);
+    SuiteSparse_free(order);
+    if (!G)
+        LogError("Error: Ran out of memory in Mongoose::generate_geometric\n");
+    return G;
+}
+
+Graph *generate_rmat(Int scale, Int edge_factor, double a, double b, double c,
+                     Int seed)
+{
+    TraceSpan span("GenerateGraph");
+    if (scale < 1 || edge_factor < 1
+        || std::ldexp(static_cast<double>(edge_factor), static_cast<int>(scale))
+               > MaxGeneratedSize
+        || !(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1))
+    {
+        LogError("Error: An R-MAT graph needs scale > 0, edge_factor > 0, "
+                 "and probabilities a, b, c >= 0 with a + b + c <= 1\n");
+        return NULL;
+    }
+
+    Int n          = static_cast<Int>(1) << scale;
+    Int m          = edge_factor * n;
+    uint64_t useed = static_cast<uint64_t>(seed);
+
+    // Renumber the vertices, so that the high degree ones are spread out.
+    Int *perm = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    cs *T     = cs_spalloc(n, n, m, 0, 1);
+    if (!perm || !T)
+    {
+        SuiteSparse_free(perm);
+        cs_spfree(T);
+        LogError("Error: Ran out of memory in Mongoose::generate_rmat\n");
+        return NULL;
+    }
+    for (Int v = 0; v < n; v++)
+        perm[v] = v;
+    for (Int v = n - 1; v > 0; v--)
+        std::swap(perm[v], perm[randomIndex(useed ^ PermutationStream, v, 0,
+                                            v + 1)]);
+
+    Int *Ti = T->i;
+    Int *Tj = T->p;
+    parallelFor(0, m, MinParallelEdges, [&](Int k0, Int k1) {
+        for (Int k = k0; k < k1; k++)
+        {
+            Int u = 0, v = 0;
+            for (Int level = 0; level < scale; level++)
+            {
+                double r = randomUniform(useed, k, level);
+                Int bit  = static_cast<Int>(1) << level;
+                if (r >= a + b + c)
+                {
+                    u |= bit;
+                    v |= bit;
+                }
+                else if (r >= a + b)
+                {
+                    u |= bit;
+                }
+                else if (r >= a)
+                {
+                    v |= bit;
+                }
+            }
+            Ti[k] = perm[u];
+            Tj[k] = perm[v];
+        }
+    });
+    T->nz = m;
+    SuiteSparse_free(perm);
+
+    Graph *G = graphFromEdges(T);
+    if (!G)
+        LogError("Error: Ran out of memory in Mongoose::generate_rmat\n");
+    return G;
+}
+
+Graph *generate_erdos_renyi(Int n, double average_degree, Int seed)
+{
+    TraceSpan span("GenerateGraph");
+    if (n < 2 || !(average_degree > 0)
+        || static_cast<double>(n) * average_degree > MaxGeneratedSize)
+    {
+        LogError("Error: An Erdos-Renyi graph needs n > 1 and a positive "
+                 "average degree\n");
+        return NULL;
+    }
+
+    Int m          = static_cast<Int>(n * average_degree / 2 + 0.5);
+    uint64_t useed = static_cast<uint64_t>(seed);
+    cs *T          = cs_spalloc(n, n, std::max<Int>(1, m), 0, 1);
+    if (!T)
+    {
+        LogError("Error: Ran out of memory in Mongoose::generate_erdos_renyi"
+                 "\n");
+        return NULL;
+    }
+
+    Int *Ti = T->i;
+    Int *Tj = T->p;
+    parallelFor(0, m, MinParallelEdges, [&](Int k0, Int k1) {
+        for (Int k = k0; k < k1; k++)
+        {
+            Ti[k] = randomIndex(useed, k, 0, n);
+            Tj[k] = randomIndex(useed, k, 1, n);
+        }
+    });
+    T->nz = m;
+
+    Graph *G = graphFromEdges(T);
+    if (!G)
+        LogError("Error: Ran out of memory in Mongoose::generate_erdos_renyi"
+                 "\n");
+    return G;
+}
+
+/* Split spec into its family, size and optional seed. */
+static bool parseSpec(const std::string &spec, std::string &family,
+                      Int &size, Int &seed)
+{
+    size_t colon = spec.find(':');
+    if (colon == std::string::npos)
+        return false;
+    family = spec.substr(0, colon);
+
+    const char *s = spec.c_str() + colon + 1;
+    char *end;
+    size = static_cast<Int>(strtoll(s, &end, 10));
+    if (end == s)
+        return false;
+    seed = 1;
+    if (*end == ':')
+    {
+        s    = end + 1;
+        seed = static_cast<Int>(strtoll(s, &end, 10));
+        if (end == s)
+            return false;
+    }
+    return *end == '\0';
+}
+
+bool isGeneratorSpec(const std::string &name)
+{
+    static const char *const families[]
+        = { "grid2d", "grid3d", "mesh2d", "mesh3d",
+            "geo2d",  "geo3d",  "rmat",   "er" };
+
+    std::string family;
+    Int size, seed;
+    if (!parseSpec(name, family, size, seed))
+        return false;
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++)
+    {
+        if (family == families[f])
+            return true;
+    }
+    return false;
+}
+
+Graph *generate_graph(const std::string &spec)
+{
+    std::string family;
+    Int size, seed;
+    if (!isGeneratorSpec(spec) || !parseSpec(spec, family, size, seed))
+    {
+        LogError("Error: Unknown graph specification " << spec << "\n");
+        return NULL;
+    }
+
+    if (family == "grid2d")
+        return generate_grid(size, size);
+    if (family == "grid3d")
+        return generate_grid(size, size, size);
+    if (family == "mesh2d")
+        return generate_mesh(size, size);
+    if (family == "mesh3d")
+        return generate_mesh(size, size, size);
+    if (family == "geo2d")
+        return generate_geometric(size, SpecAverageDegree, 2, seed);
+    if (family == "geo3d")
+        return generate_geometric(size, SpecAverageDegree, 3, seed);
+    if (family == "rmat")
+        return generate_rmat(size, SpecEdgeFactor, 0.57, 0.19, 0.19, seed);
+    return generate_erdos_renyi(size, SpecAverageDegree, seed);
+}
+
+Graph *generate_graph(const char *spec)
+{
+    return generate_graph(std::string(spec));
+}
+
+} // end namespace Mongoose
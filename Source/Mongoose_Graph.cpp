@@ -14,6 +14,10 @@
 #include <algorithm>
 #include <new>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
 namespace Mongoose
 {
 
@@ -25,6 +29,11 @@ Graph::Graph()
     i      = NULL;
     x      = NULL;
     w      = NULL;
+
+    shallow_p = shallow_i = shallow_x = shallow_w = false;
+
+    mapping     = NULL;
+    mappingSize = 0;
 }
 
 Graph *Graph::create(const Int _n, const Int _nz, Int *_p, Int *_i, double *_x,
@@ -113,6 +122,11 @@ Graph::~Graph()
     x = (shallow_x) ? NULL : (double *)SuiteSparse_free(x);
     w = (shallow_w) ? NULL : (double *)SuiteSparse_free(w);
 
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping)
+        munmap(mapping, mappingSize);
+#endif
+
     SuiteSparse_free(this);
 }
 
@@ -0,0 +1,397 @@
+/* ========================================================================== */
+/* === Source/Mongoose_GraphFormats.cpp ===================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Parallel readers for METIS/Chaco graph files and binary edge lists
+ *
+ * A METIS file is read in two passes over line-aligned chunks, like the
+ * Matrix Market reader. The first pass counts the vertex lines and adjacency
+ * entries of each chunk, which gives each chunk its first vertex and its
+ * offset into the triplet arrays. The second pass parses the chunks
+ * concurrently. Binary edge lists have fixed size records, so they are simply
+ * split into equal slices.
+ */
+
+#include "Mongoose_GraphFormats.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_Parse.hpp"
+
+#include <stdint.h>
+
+namespace Mongoose
+{
+
+namespace
+{
+
+/* Chunks smaller than this are not worth a thread of their own. */
+const size_t MinChunkSize = 1 << 20;
+
+/* Edge list slices smaller than this are not worth a thread of their own. */
+const Int MinParallelRecords = 1 << 16;
+
+/* The rest of a file, either memory mapped or read into a buffer. */
+struct FileData
+{
+    MappedFile map;
+    char *buffer;
+    const char *data;
+    const char *end;
+};
+
+bool loadFile(FILE *file, FileData &contents)
+{
+    contents.buffer = NULL;
+    if (mapFile(file, contents.map))
+    {
+        contents.data = contents.map.data;
+        contents.end  = contents.map.end;
+        return true;
+    }
+
+    // Memory mapping is not available; read the whole file instead.
+    long start = ftell(file);
+    if (start < 0 || fseek(file, 0, SEEK_END) != 0)
+        return false;
+    long stop = ftell(file);
+    if (stop < start || fseek(file, start, SEEK_SET) != 0)
+        return false;
+    size_t size     = static_cast<size_t>(stop - start);
+    contents.buffer = (char *)SuiteSparse_malloc(size, 1);
+    if (!contents.buffer || fread(contents.buffer, 1, size, file) != size)
+    {
+        SuiteSparse_free(contents.buffer);
+        contents.buffer = NULL;
+        return false;
+    }
+    contents.data = contents.buffer;
+    contents.end  = contents.buffer + size;
+    return true;
+}
+
+void releaseFile(FileData &contents)
+{
+    if (contents.buffer)
+        SuiteSparse_free(contents.buffer);
+    else
+        unmapFile(contents.map);
+}
+
+struct MetisFormat
+{
+    Int n;            /* # of vertices                             */
+    Int m;            /* # of (undirected) edges                   */
+    Int leading;      /* # of values before the adjacency list      */
+    Int ncon;         /* # of vertex weights                        */
+    bool hasSizes;    /* each line starts with a vertex size/number */
+    bool hasXWeights; /* each neighbor is followed by a weight      */
+};
+
+inline bool isComment(const char *s, const char *end)
+{
+    return (s < end && *s == '%');
+}
+
+/* Count the vertex lines and adjacency entries in a chunk. */
+void countMetisChunk(Chunk *chunk, const MetisFormat *format)
+{
+    const char *s   = chunk->begin;
+    const char *end = chunk->end;
+    Int perEntry    = (format->hasXWeights) ? 2 : 1;
+    Int lines = 0, count = 0;
+    while (s < end)
+    {
+        if (isComment(s, end))
+        {
+            s = nextLine(s, end);
+            continue;
+        }
+
+        Int tokens   = 0;
+        bool inToken = false;
+        for (; s < end && *s != '\n'; s++)
+        {
+            bool blank = isBlank(*s);
+            if (!blank && !inToken)
+                tokens++;
+            inToken = !blank;
+        }
+        if (s < end)
+            s++;
+
+        lines++;
+        if (tokens > format->leading)
+            count += (tokens - format->leading) / perEntry;
+    }
+    chunk->lines = lines;
+    chunk->count = count;
+}
+
+void parseMetisChunk(Chunk *chunk, const MetisFormat *format, Int *I, Int *J,
+                     double *X, double *W)
+{
+    const char *s   = chunk->begin;
+    const char *end = chunk->end;
+    Int n           = format->n;
+    Int v           = chunk->line;
+    Int k           = chunk->offset;
+    Int last        = chunk->offset + chunk->count;
+
+    chunk->ok = false;
+    for (; s < end; s = nextLine(s, end))
+    {
+        if (isComment(s, end))
+            continue;
+
+        if (v >= n)
+        {
+            // Only blank lines may follow the last vertex
+            if (moreOnLine(s, end))
+                return;
+            v++;
+            continue;
+        }
+
+        Int skip;
+        if (format->hasSizes && !parseIndex(s, end, skip))
+            return;
+        for (Int c = 0; c < format->ncon; c++)
+        {
+            double weight;
+            if (!parseValue(s, end, weight))
+                return;
+            if (c == 0)
+                W[v] = weight;
+        }
+
+        while (moreOnLine(s, end))
+        {
+            Int u;
+            double x = 1;
+            if (k >= last || !parseIndex(s, end, u) || u < 1 || u > n
+                || (format->hasXWeights && !parseValue(s, end, x)))
+            {
+                return;
+            }
+            I[k] = v;
+            J[k] = u - 1;
+            if (X)
+                X[k] = x;
+            k++;
+        }
+        v++;
+    }
+    chunk->ok = (k == last);
+}
+
+/* Parse the header line: n m [fmt [ncon]]. */
+bool parseMetisHeader(const char *&s, const char *end, MetisFormat &format)
+{
+    while (s < end && (isComment(s, end) || !moreOnLine(s, end)))
+        s = nextLine(s, end);
+
+    Int fmt = 0, ncon = -1;
+    if (!parseIndex(s, end, format.n) || !parseIndex(s, end, format.m))
+        return false;
+    if (moreOnLine(s, end) && !parseIndex(s, end, fmt))
+        return false;
+    if (moreOnLine(s, end) && !parseIndex(s, end, ncon))
+        return false;
+    if (moreOnLine(s, end) || fmt % 10 > 1 || (fmt / 10) % 10 > 1
+        || fmt / 100 > 1)
+    {
+        return false;
+    }
+    s = nextLine(s, end);
+
+    format.hasXWeights = (fmt % 10 == 1);
+    format.hasSizes    = (fmt / 100 == 1);
+    bool hasWeights    = ((fmt / 10) % 10 == 1);
+    format.ncon        = (hasWeights) ? ((ncon < 0) ? 1 : ncon) : 0;
+    format.leading     = format.ncon + ((format.hasSizes) ? 1 : 0);
+    return (!hasWeights || format.ncon > 0);
+}
+
+} // end anonymous namespace
+
+cs *readMetisTriplets(FILE *file, double **vertexWeights)
+{
+    *vertexWeights = NULL;
+
+    FileData contents;
+    if (!loadFile(file, contents))
+    {
+        LogError("Error: Could not read graph file\n");
+        return NULL;
+    }
+
+    const char *s = contents.data;
+    MetisFormat format;
+    if (!parseMetisHeader(s, contents.end, format))
+    {
+        LogError("Error: Could not parse METIS graph header\n");
+        releaseFile(contents);
+        return NULL;
+    }
+
+    /* Pass 1: count the vertex lines and entries in each chunk. */
+    std::vector<Chunk> chunks;
+    splitLines(s, contents.end, MinChunkSize, chunks);
+    size_t numThreads = chunks.size();
+    runThreads(numThreads,
+               [&](size_t t) { countMetisChunk(&chunks[t], &format); });
+
+    Int nz    = chunkOffsets(chunks);
+    Int lines = chunks.back().line + chunks.back().lines;
+    if (nz != 2 * format.m || lines < format.n)
+    {
+        LogError("Error: Expected " << format.n << " vertices and "
+                                    << 2 * format.m
+                                    << " adjacency entries in the file but "
+                                       "found "
+                                    << lines << " and " << nz << "\n");
+        releaseFile(contents);
+        return NULL;
+    }
+
+    cs *T     = cs_spalloc(format.n, format.n, nz, format.hasXWeights, 1);
+    double *W = (format.ncon > 0)
+                    ? (double *)SuiteSparse_malloc(
+                          static_cast<size_t>(format.n), sizeof(double))
+                    : NULL;
+    if (!T || (format.ncon > 0 && !W))
+    {
+        LogError("Error: Ran out of memory in Mongoose::readMetisTriplets\n");
+        cs_spfree(T);
+        SuiteSparse_free(W);
+        releaseFile(contents);
+        return NULL;
+    }
+
+    /* Pass 2: parse the chunks into their slices of the triplets. */
+    runThreads(numThreads, [&](size_t t) {
+        parseMetisChunk(&chunks[t], &format, T->i, T->p, T->x, W);
+    });
+    releaseFile(contents);
+
+    bool ok = true;
+    for (size_t t = 0; t < numThreads; t++)
+        ok = ok && chunks[t].ok;
+    if (!ok)
+    {
+        LogError("Error: Invalid vertex line in METIS graph file\n");
+        cs_spfree(T);
+        SuiteSparse_free(W);
+        return NULL;
+    }
+
+    T->nz          = nz;
+    *vertexWeights = W;
+    return T;
+}
+
+cs *readEdgeListTriplets(FILE *file, size_t indexWidth, bool weighted)
+{
+    if (indexWidth != 4 && indexWidth != 8)
+    {
+        LogError("Error: Edge list indices must be 4 or 8 bytes wide\n");
+        return NULL;
+    }
+
+    FileData contents;
+    if (!loadFile(file, contents))
+    {
+        LogError("Error: Could not read edge list file\n");
+        return NULL;
+    }
+
+    size_t recordSize = 2 * indexWidth + ((weighted) ? sizeof(double) : 0);
+    size_t bytes      = static_cast<size_t>(contents.end - contents.data);
+    if (bytes % recordSize != 0)
+    {
+        LogError("Error: Edge list file size is not a whole number of "
+                 "records\n");
+        releaseFile(contents);
+        return NULL;
+    }
+
+    Int nz = static_cast<Int>(bytes / recordSize);
+    cs *T  = cs_spalloc(0, 0, nz, weighted, 1);
+    if (!T)
+    {
+        LogError("Error: Ran out of memory in Mongoose::readEdgeListTriplets\n");
+        releaseFile(contents);
+        return NULL;
+    }
+
+    size_t numThreads = parallelThreads(nz, MinParallelRecords);
+    std::vector<Int> maxIndex(numThreads, -1);
+    std::vector<char> valid(numThreads, 1);
+    const char *data = contents.data;
+    runThreads(numThreads, [&](size_t t) {
+        Int k0  = static_cast<Int>(nz * t / numThreads);
+        Int k1  = static_cast<Int>(nz * (t + 1) / numThreads);
+        Int max = -1;
+        for (Int k = k0; k < k1; k++)
+        {
+            const char *record = data + static_cast<size_t>(k) * recordSize;
+            Int u, v;
+            if (indexWidth == 4)
+            {
+                int32_t u32, v32;
+                memcpy(&u32, record, 4);
+                memcpy(&v32, record + 4, 4);
+                u = u32;
+                v = v32;
+            }
+            else
+            {
+                int64_t u64, v64;
+                memcpy(&u64, record, 8);
+                memcpy(&v64, record + 8, 8);
+                u = static_cast<Int>(u64);
+                v = static_cast<Int>(v64);
+            }
+            if (u < 0 || v < 0)
+            {
+                valid[t] = 0;
+                return;
+            }
+            T->i[k] = u;
+            T->p[k] = v;
+            if (weighted)
+                memcpy(&T->x[k], record + 2 * indexWidth, sizeof(double));
+            max = std::max(max, std::max(u, v));
+        }
+        maxIndex[t] = max;
+    });
+    releaseFile(contents);
+
+    Int n = 0;
+    for (size_t t = 0; t < numThreads; t++)
+    {
+        if (!valid[t])
+        {
+            LogError("Error: Negative vertex index in edge list\n");
+            cs_spfree(T);
+            return NULL;
+        }
+        n = std::max(n, maxIndex[t] + 1);
+    }
+
+    T->m  = n;
+    T->n  = n;
+    T->nz = nz;
+    return T;
+}
+
+} // end namespace Mongoose
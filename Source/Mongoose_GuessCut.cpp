@@ -13,6 +13,7 @@
 #include "Mongoose_ImproveQP.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Random.hpp"
+#include "Mongoose_Trace.hpp"
 #include "Mongoose_Waterdance.hpp"
 
 namespace Mongoose
@@ -23,6 +24,8 @@ namespace Mongoose
 //-----------------------------------------------------------------------------
 bool guessCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
+    TraceSpan span("GuessCut", graph->clevel);
+
     switch (options->initial_cut_type)
     {
     case InitialEdgeCut_QP:
@@ -40,13 +43,18 @@ bool guessCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
         }
         break;
     case InitialEdgeCut_Random:
+    {
+        // Each vertex picks its side from the seed, its level and itself
+        uint64_t key = randomKey(options->random_seed, graph->clevel);
         for (Int k = 0; k < graph->n; k++)
         {
-            graph->partition[k] = (random() % 2 == 0);
+            graph->partition[k] = (randomBits(key, static_cast<uint64_t>(k))
+                                   & 1);
         }
 
         bhLoad(graph, options);
         break;
+    }
     case InitialEdgeCut_NaturalOrder:
         for (Int k = 0; k < graph->n; k++)
         {
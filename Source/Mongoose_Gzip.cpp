@@ -0,0 +1,262 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Gzip.cpp ============================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Gzip.hpp"
+#include "Mongoose_Logger.hpp"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef MONGOOSE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace Mongoose
+{
+
+/* Amount of text decompressed into each block, and the number of blocks.
+ * With three blocks, one can be parsed while the next is decompressed and a
+ * third is ready to go. */
+static const size_t BlockSize = 8 << 20;
+static const size_t NumBlocks = 3;
+
+bool isGzipFile(FILE *file)
+{
+    long start = ftell(file);
+    unsigned char magic[2];
+    bool gzip = (fread(magic, 1, 2, file) == 2 && magic[0] == 0x1f
+                 && magic[1] == 0x8b);
+    fseek(file, start, SEEK_SET);
+    return gzip;
+}
+
+struct GzipStream::State
+{
+    struct Block
+    {
+        std::vector<char> text;
+        size_t length;
+    };
+
+    std::vector<Block> blocks;
+    std::deque<size_t> freeBlocks; /* ready to be filled              */
+    std::deque<size_t> fullBlocks; /* decompressed, waiting to parse  */
+    Int current;                   /* block held by the reader, or -1 */
+    bool done;
+    bool error;
+    bool stopping;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::thread inflater;
+
+    State() : current(-1), done(false), error(false), stopping(false) {}
+};
+
+GzipStream::GzipStream()
+{
+    file  = NULL;
+    state = NULL;
+}
+
+GzipStream *GzipStream::create(const char *filename)
+{
+#ifdef MONGOOSE_HAVE_ZLIB
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(GzipStream));
+    if (!memoryLocation)
+        return NULL;
+
+    // Placement new
+    GzipStream *stream = new (memoryLocation) GzipStream();
+
+    gzFile gz = gzopen(filename, "rb");
+    if (!gz)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        stream->~GzipStream();
+        return NULL;
+    }
+    gzbuffer(gz, 1 << 17);
+    stream->file = gz;
+
+    void *stateLocation = SuiteSparse_malloc(1, sizeof(State));
+    if (!stateLocation)
+    {
+        LogError("Error: Ran out of memory in Mongoose::GzipStream\n");
+        stream->~GzipStream();
+        return NULL;
+    }
+    stream->state = new (stateLocation) State();
+
+    try
+    {
+        State *state = stream->state;
+        state->blocks.resize(NumBlocks);
+        for (size_t b = 0; b < NumBlocks; b++)
+        {
+            state->blocks[b].text.resize(BlockSize);
+            state->freeBlocks.push_back(b);
+        }
+        state->inflater = std::thread(&GzipStream::inflateBlocks, stream);
+    }
+    catch (...)
+    {
+        LogError("Error: Ran out of memory in Mongoose::GzipStream\n");
+        stream->~GzipStream();
+        return NULL;
+    }
+
+    return stream;
+#else
+    LogError("Error: Cannot read " << std::string(filename)
+                                   << ": Mongoose was built without zlib\n");
+    return NULL;
+#endif
+}
+
+/* Runs on the inflater thread.  The partial line at the end of each block is
+ * carried over to the start of the next, so every block but the last ends
+ * with a newline. */
+void GzipStream::inflateBlocks()
+{
+#ifdef MONGOOSE_HAVE_ZLIB
+    gzFile gz     = (gzFile)file;
+    State &shared = *state;
+    std::vector<char> tail;
+    try
+    {
+        for (;;)
+        {
+            size_t b;
+            {
+                std::unique_lock<std::mutex> guard(shared.lock);
+                shared.changed.wait(guard, [&] {
+                    return shared.stopping || !shared.freeBlocks.empty();
+                });
+                if (shared.stopping)
+                    return;
+                b = shared.freeBlocks.front();
+                shared.freeBlocks.pop_front();
+            }
+
+            State::Block &block = shared.blocks[b];
+            size_t length       = tail.size();
+            if (block.text.size() < length + BlockSize)
+                block.text.resize(length + BlockSize);
+            if (length > 0)
+                memcpy(&block.text[0], &tail[0], length);
+
+            int got = gzread(gz, &block.text[length],
+                             static_cast<unsigned>(BlockSize));
+            // A truncated stream still returns the text it could inflate,
+            // and only gzerror reports the problem.
+            int status = Z_OK;
+            if (got >= 0 && static_cast<size_t>(got) < BlockSize)
+                gzerror(gz, &status);
+            if (got < 0 || status != Z_OK)
+            {
+                std::lock_guard<std::mutex> guard(shared.lock);
+                shared.error = true;
+                shared.changed.notify_all();
+                return;
+            }
+            length += static_cast<size_t>(got);
+
+            // gzread only comes up short at the end of the file
+            bool last = (static_cast<size_t>(got) < BlockSize);
+            if (!last)
+            {
+                size_t cut = length;
+                while (cut > 0 && block.text[cut - 1] != '\n')
+                    cut--;
+                tail.assign(block.text.begin() + static_cast<long>(cut),
+                            block.text.begin() + static_cast<long>(length));
+                length = cut;
+            }
+            block.length = length;
+
+            std::lock_guard<std::mutex> guard(shared.lock);
+            if (length > 0 || last)
+                shared.fullBlocks.push_back(b);
+            else
+                shared.freeBlocks.push_back(b); // a line longer than a block
+            shared.done = last;
+            shared.changed.notify_all();
+            if (last)
+                return;
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> guard(shared.lock);
+        shared.error = true;
+        shared.changed.notify_all();
+    }
+#endif
+}
+
+bool GzipStream::next(const char *&data, const char *&end)
+{
+    std::unique_lock<std::mutex> guard(state->lock);
+    if (state->current >= 0)
+    {
+        state->freeBlocks.push_back(static_cast<size_t>(state->current));
+        state->current = -1;
+        state->changed.notify_all();
+    }
+    state->changed.wait(guard, [&] {
+        return state->error || state->done || !state->fullBlocks.empty();
+    });
+    if (state->error || state->fullBlocks.empty())
+        return false;
+
+    size_t b = state->fullBlocks.front();
+    state->fullBlocks.pop_front();
+    state->current = static_cast<Int>(b);
+    data           = &state->blocks[b].text[0];
+    end            = data + state->blocks[b].length;
+    return true;
+}
+
+bool GzipStream::failed()
+{
+    std::lock_guard<std::mutex> guard(state->lock);
+    return state->error;
+}
+
+GzipStream::~GzipStream()
+{
+    if (state)
+    {
+        {
+            std::lock_guard<std::mutex> guard(state->lock);
+            state->stopping = true;
+            state->changed.notify_all();
+        }
+        if (state->inflater.joinable())
+            state->inflater.join();
+        state->~State();
+        SuiteSparse_free(state);
+    }
+
+#ifdef MONGOOSE_HAVE_ZLIB
+    if (file)
+        gzclose((gzFile)file);
+#endif
+
+    SuiteSparse_free(this);
+}
+
+} // end namespace Mongoose
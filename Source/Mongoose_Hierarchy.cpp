@@ -0,0 +1,486 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Hierarchy.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Hierarchy.hpp"
+#include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Trace.hpp"
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MONGOOSE_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+namespace Mongoose
+{
+
+bool optionsAreValid(const EdgeCut_Options *options);
+
+/* Mongoose hierarchy file header.  The header is followed by one
+ * HierarchyLevel per level, finest first, and then by the arrays of each
+ * level in the order listed in LevelLayout, each padded to a multiple of 8
+ * bytes. Indices are stored as native Int so that they can be used in place. */
+struct HierarchyHeader
+{
+    char magic[8];       /* "MONGHIER"                          */
+    uint32_t version;    /* HierarchyVersion                    */
+    uint32_t byteOrder;  /* HierarchyByteOrder, in native order */
+    uint32_t indexWidth; /* sizeof(Int)                         */
+    uint32_t reserved;
+    int64_t numLevels;
+};
+
+struct HierarchyLevel
+{
+    int64_t n;      /* # vertices                                   */
+    int64_t nz;     /* # edges                                      */
+    int64_t cn;     /* # vertices in the next level, 0 if coarsest  */
+    uint32_t flags; /* Hierarchy_EdgeWeights, Hierarchy_VertexWeights */
+    uint32_t reserved;
+    double X;
+    double W;
+    double H;
+    double worstCaseRatio;
+    uint64_t offset; /* of the first array of the level */
+};
+
+static const char HierarchyMagic[8]      = { 'M', 'O', 'N', 'G',
+                                        'H', 'I', 'E', 'R' };
+static const uint32_t HierarchyVersion   = 1;
+static const uint32_t HierarchyByteOrder = 0x01020304;
+static const uint32_t Hierarchy_EdgeWeights   = 1;
+static const uint32_t Hierarchy_VertexWeights = 2;
+
+static inline size_t align8(size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+/* File offsets of the arrays of one level.  Absent arrays take no space. */
+struct LevelLayout
+{
+    size_t p, i, x, w, gains;
+    size_t matching, matchmap, invmatchmap, matchtype;
+    size_t end;
+
+    LevelLayout(const HierarchyLevel &level)
+    {
+        size_t n  = static_cast<size_t>(level.n);
+        size_t nz = static_cast<size_t>(level.nz);
+        size_t cn = static_cast<size_t>(level.cn);
+        bool hasX = (level.flags & Hierarchy_EdgeWeights) != 0;
+        bool hasW = (level.flags & Hierarchy_VertexWeights) != 0;
+        p           = static_cast<size_t>(level.offset);
+        i           = p + align8((n + 1) * sizeof(Int));
+        x           = i + align8(nz * sizeof(Int));
+        w           = x + ((hasX) ? align8(nz * sizeof(double)) : 0);
+        gains       = w + ((hasW) ? align8(n * sizeof(double)) : 0);
+        matching    = gains + align8(n * sizeof(double));
+        matchmap    = matching + ((cn) ? align8(n * sizeof(Int)) : 0);
+        invmatchmap = matchmap + ((cn) ? align8(n * sizeof(Int)) : 0);
+        matchtype   = invmatchmap + ((cn) ? align8(cn * sizeof(Int)) : 0);
+        end         = matchtype + ((cn) ? align8(n * sizeof(Int)) : 0);
+    }
+};
+
+/* Write count items of the given size at the current position, which must
+ * be offset, followed by zero padding up to a multiple of 8 bytes. */
+static bool writeArray(FILE *file, size_t offset, const void *data,
+                       size_t count, size_t size)
+{
+    if (static_cast<size_t>(ftell(file)) != offset
+        || fwrite(data, size, count, file) != count)
+        return false;
+
+    static const char zeros[8] = { 0 };
+    size_t padding = align8(count * size) - count * size;
+    return (fwrite(zeros, 1, padding, file) == padding);
+}
+
+static bool writeLevels(FILE *file, EdgeCutProblem **levels,
+                        HierarchyLevel *table, size_t numLevels)
+{
+    HierarchyHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HierarchyMagic, sizeof(HierarchyMagic));
+    header.version    = HierarchyVersion;
+    header.byteOrder  = HierarchyByteOrder;
+    header.indexWidth = sizeof(Int);
+    header.numLevels  = static_cast<int64_t>(numLevels);
+
+    size_t offset = sizeof(header) + numLevels * sizeof(HierarchyLevel);
+    for (size_t k = 0; k < numLevels; k++)
+    {
+        EdgeCutProblem *graph = levels[k];
+        HierarchyLevel &level = table[k];
+        memset(&level, 0, sizeof(level));
+        level.n     = static_cast<int64_t>(graph->n);
+        level.nz    = static_cast<int64_t>(graph->nz);
+        level.cn    = (k + 1 < numLevels) ? graph->cn : 0;
+        level.flags = ((graph->x) ? Hierarchy_EdgeWeights : 0)
+                      | ((graph->w) ? Hierarchy_VertexWeights : 0);
+        level.X              = graph->X;
+        level.W              = graph->W;
+        level.H              = graph->H;
+        level.worstCaseRatio = graph->worstCaseRatio;
+        level.offset         = static_cast<uint64_t>(offset);
+        offset               = LevelLayout(level).end;
+    }
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1
+        || fwrite(table, sizeof(HierarchyLevel), numLevels, file)
+               != numLevels)
+        return false;
+
+    for (size_t k = 0; k < numLevels; k++)
+    {
+        EdgeCutProblem *graph = levels[k];
+        LevelLayout layout(table[k]);
+        size_t n  = static_cast<size_t>(table[k].n);
+        size_t nz = static_cast<size_t>(table[k].nz);
+        size_t cn = static_cast<size_t>(table[k].cn);
+        bool ok
+            = writeArray(file, layout.p, graph->p, n + 1, sizeof(Int))
+              && writeArray(file, layout.i, graph->i, nz, sizeof(Int))
+              && (!graph->x
+                  || writeArray(file, layout.x, graph->x, nz, sizeof(double)))
+              && (!graph->w
+                  || writeArray(file, layout.w, graph->w, n, sizeof(double)))
+              && writeArray(file, layout.gains, graph->vertexGains, n,
+                            sizeof(double))
+              && (!cn
+                  || (writeArray(file, layout.matching, graph->matching, n,
+                                 sizeof(Int))
+                      && writeArray(file, layout.matchmap, graph->matchmap, n,
+                                    sizeof(Int))
+                      && writeArray(file, layout.invmatchmap,
+                                    graph->invmatchmap, cn, sizeof(Int))
+                      && writeArray(file, layout.matchtype, graph->matchtype,
+                                    n, sizeof(Int))));
+        if (!ok)
+            return false;
+    }
+
+    return true;
+}
+
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const std::string &filename)
+{
+    return write_hierarchy(graph, options, filename.c_str());
+}
+
+bool write_hierarchy(const Graph *graph, const EdgeCut_Options *options,
+                     const char *filename)
+{
+    if (!optionsAreValid(options))
+        return false;
+
+    if (!graph)
+    {
+        LogError("Error: Cannot write the hierarchy of a NULL graph\n");
+        return false;
+    }
+
+    EdgeCutProblem *problem = EdgeCutProblem::create(graph);
+    if (!problem)
+    {
+        LogError("Error: Ran out of memory in Mongoose::write_hierarchy\n");
+        return false;
+    }
+    problem->initialize(options);
+
+    EdgeCutProblem *coarsest = coarsenHierarchy(problem, options);
+    size_t numLevels
+        = (coarsest) ? static_cast<size_t>(coarsest->clevel) + 1 : 0;
+    EdgeCutProblem **levels = (EdgeCutProblem **)SuiteSparse_malloc(
+        numLevels, sizeof(EdgeCutProblem *));
+    HierarchyLevel *table = (HierarchyLevel *)SuiteSparse_malloc(
+        numLevels, sizeof(HierarchyLevel));
+    bool ok = false;
+    if (!coarsest || !levels || !table)
+    {
+        LogError("Error: Ran out of memory in Mongoose::write_hierarchy\n");
+    }
+    else
+    {
+        for (EdgeCutProblem *level = coarsest; level; level = level->parent)
+            levels[level->clevel] = level;
+
+        TraceSpan span("WriteHierarchy");
+        Logger::tic(IOTiming);
+        LogInfo("Writing hierarchy to file " << std::string(filename)
+                                             << "\n");
+        FILE *file = fopen(filename, "wb");
+        if (!file)
+        {
+            LogError("Error: Cannot write file " << std::string(filename)
+                                                 << "\n");
+        }
+        else
+        {
+            ok = writeLevels(file, levels, table, numLevels);
+            ok = (fclose(file) == 0) && ok;
+            if (!ok)
+                LogError("Error: Could not write hierarchy file\n");
+        }
+        Logger::toc(IOTiming);
+    }
+
+    SuiteSparse_free(levels);
+    SuiteSparse_free(table);
+    while (coarsest && coarsest != problem)
+    {
+        EdgeCutProblem *next = coarsest->parent;
+        coarsest->~EdgeCutProblem();
+        coarsest = next;
+    }
+    problem->~EdgeCutProblem();
+
+    return ok;
+}
+
+/* Destroy the levels from graph up to and including the finest one. */
+static void freeLevels(EdgeCutProblem *graph)
+{
+    while (graph)
+    {
+        EdgeCutProblem *next = graph->parent;
+        graph->~EdgeCutProblem();
+        graph = next;
+    }
+}
+
+/* Whether a level read from a file is a graph whose matching maps it onto
+ * the next coarser level of cn vertices, checked in one pass over its
+ * arrays: p is monotone from 0 to nz, every edge ends at a vertex, every
+ * vertex is matched to a vertex and mapped to a coarse vertex, and every
+ * coarse vertex comes from a vertex. */
+static bool levelIsValid(const EdgeCutProblem *graph, const Int *matching,
+                         const Int *matchmap, const Int *invmatchmap, Int cn)
+{
+    Int n  = graph->n;
+    Int *p = graph->p;
+    Int *i = graph->i;
+
+    bool valid = (p[0] == 0 && p[n] == graph->nz);
+    for (Int k = 0; valid && k < n; k++)
+        valid = (p[k] <= p[k + 1]);
+    for (Int k = 0; valid && k < graph->nz; k++)
+        valid = (i[k] >= 0 && i[k] < n);
+    if (cn == 0)
+        return valid;
+
+    /* matching holds each partner plus one */
+    for (Int k = 0; valid && k < n; k++)
+    {
+        valid = (matching[k] >= 1 && matching[k] <= n && matchmap[k] >= 0
+                 && matchmap[k] < cn);
+    }
+    for (Int c = 0; valid && c < cn; c++)
+        valid = (invmatchmap[c] >= 0 && invmatchmap[c] < n);
+    return valid;
+}
+
+/* Build the levels of a hierarchy file held in memory.  The graph arrays are
+ * used in place and the rest are copied into the arrays each level owns.
+ *
+ * @return the coarsest level, or NULL if the file is corrupt or memory runs
+ *   out.
+ */
+static EdgeCutProblem *loadLevels(char *data, size_t size)
+{
+    HierarchyHeader header;
+    if (size < sizeof(header))
+    {
+        LogError("Error: Not a Mongoose hierarchy file\n");
+        return NULL;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, HierarchyMagic, sizeof(HierarchyMagic)) != 0)
+    {
+        LogError("Error: Not a Mongoose hierarchy file\n");
+        return NULL;
+    }
+    if (header.version > HierarchyVersion
+        || header.byteOrder != HierarchyByteOrder
+        || header.indexWidth != sizeof(Int))
+    {
+        LogError("Error: Unsupported hierarchy version, byte order or index "
+                 "width\n");
+        return NULL;
+    }
+    if (header.numLevels < 1
+        || static_cast<uint64_t>(header.numLevels)
+               > (size - sizeof(header)) / sizeof(HierarchyLevel))
+    {
+        LogError("Error: Hierarchy file is corrupt\n");
+        return NULL;
+    }
+
+    size_t numLevels         = static_cast<size_t>(header.numLevels);
+    const char *table        = data + sizeof(header);
+    EdgeCutProblem *previous = NULL;
+    for (size_t k = 0; k < numLevels; k++)
+    {
+        HierarchyLevel level;
+        memcpy(&level, table + k * sizeof(level), sizeof(level));
+
+        // Every array holds at least 8 bytes per entry, which bounds the
+        // sizes before the layout is computed from them.
+        bool last     = (k + 1 == numLevels);
+        int64_t bound = static_cast<int64_t>(size / 8);
+        bool valid    = level.n >= 0 && level.n < bound && level.nz >= 0
+                        && level.nz < bound && level.cn >= 0
+                        && level.cn <= level.n && (level.cn == 0) == last
+                        && (!previous || level.n == previous->cn)
+                        && level.offset % 8 == 0 && level.offset < size;
+        LevelLayout layout(level);
+        if (!valid || layout.end > size)
+        {
+            LogError("Error: Hierarchy file is corrupt\n");
+            freeLevels(previous);
+            return NULL;
+        }
+
+        size_t n  = static_cast<size_t>(level.n);
+        size_t cn = static_cast<size_t>(level.cn);
+        bool hasX = (level.flags & Hierarchy_EdgeWeights) != 0;
+        bool hasW = (level.flags & Hierarchy_VertexWeights) != 0;
+        EdgeCutProblem *graph = EdgeCutProblem::create(
+            static_cast<Int>(level.n), static_cast<Int>(level.nz),
+            (Int *)(data + layout.p), (Int *)(data + layout.i),
+            (hasX) ? (double *)(data + layout.x) : NULL,
+            (hasW) ? (double *)(data + layout.w) : NULL);
+        if (!graph)
+        {
+            LogError("Error: Ran out of memory in "
+                     "Mongoose::edge_cut_hierarchy\n");
+            freeLevels(previous);
+            return NULL;
+        }
+        graph->parent = previous;
+        graph->clevel = static_cast<Int>(k);
+        previous      = graph;
+
+        if (!levelIsValid(graph, (const Int *)(data + layout.matching),
+                          (const Int *)(data + layout.matchmap),
+                          (const Int *)(data + layout.invmatchmap),
+                          static_cast<Int>(cn)))
+        {
+            LogError("Error: Hierarchy file is corrupt\n");
+            freeLevels(graph);
+            return NULL;
+        }
+
+        graph->X              = level.X;
+        graph->W              = level.W;
+        graph->H              = level.H;
+        graph->worstCaseRatio = level.worstCaseRatio;
+        memcpy(graph->vertexGains, data + layout.gains, n * sizeof(double));
+        if (cn)
+        {
+            graph->cn = static_cast<Int>(cn);
+            memcpy(graph->matching, data + layout.matching, n * sizeof(Int));
+            memcpy(graph->matchmap, data + layout.matchmap, n * sizeof(Int));
+            memcpy(graph->invmatchmap, data + layout.invmatchmap,
+                   cn * sizeof(Int));
+            memcpy(graph->matchtype, data + layout.matchtype, n * sizeof(Int));
+        }
+    }
+
+    return previous;
+}
+
+EdgeCut *edge_cut_hierarchy(const std::string &filename,
+                            const EdgeCut_Options *options)
+{
+    return edge_cut_hierarchy(filename.c_str(), options);
+}
+
+EdgeCut *edge_cut_hierarchy(const char *filename,
+                            const EdgeCut_Options *options)
+{
+    if (!optionsAreValid(options))
+        return NULL;
+
+    TraceSpan span("EdgeCutHierarchy");
+    Logger::tic(IOTiming);
+    LogInfo("Reading hierarchy from file " << std::string(filename) << "\n");
+
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    size_t size = (fileSize > 0) ? static_cast<size_t>(fileSize) : 0;
+
+    // The graph arrays are used in place, so the file is mapped copy-on-write
+    // (or read into memory) and kept until the edge cut is done.
+    char *data  = NULL;
+    bool mapped = false;
+#ifdef MONGOOSE_HAVE_MMAP
+    if (size > 0)
+    {
+        void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                         fileno(file), 0);
+        if (map != MAP_FAILED)
+        {
+            data   = static_cast<char *>(map);
+            mapped = true;
+        }
+    }
+#endif
+    if (!data && size > 0)
+    {
+        data = (char *)SuiteSparse_malloc(size, sizeof(char));
+        if (data && fread(data, 1, size, file) != size)
+            data = (char *)SuiteSparse_free(data);
+    }
+    fclose(file);
+
+    EdgeCutProblem *coarsest = NULL;
+    if (data)
+        coarsest = loadLevels(data, size);
+    else
+        LogError("Error: Could not load hierarchy file\n");
+    Logger::toc(IOTiming);
+
+    EdgeCut *result = NULL;
+    if (coarsest)
+    {
+        EdgeCutProblem *problem = coarsest;
+        while (problem->parent)
+            problem = problem->parent;
+
+        result = refineHierarchy(coarsest, options);
+        problem->~EdgeCutProblem();
+    }
+
+#ifdef MONGOOSE_HAVE_MMAP
+    if (mapped)
+        munmap(data, size);
+#endif
+    if (!mapped)
+        SuiteSparse_free(data);
+
+    return result;
+}
+
+} // end namespace Mongoose
@@ -19,16 +19,287 @@
  */
 
 #include "Mongoose_IO.hpp"
+#include "Mongoose_GraphFormats.hpp"
+#include "Mongoose_Gzip.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_MatrixMarket.hpp"
+#include "Mongoose_Parse.hpp"
 #include "Mongoose_Sanitize.hpp"
+#include "Mongoose_Trace.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MONGOOSE_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 namespace Mongoose
 {
 
+/* Mongoose binary graph file header.  The header is always 64 bytes, and is
+ * followed by p, i, x (if present) and w (if present), each padded to a
+ * multiple of 8 bytes. */
+struct BinaryGraphHeader
+{
+    char magic[8];       /* "MONGOOSE"                            */
+    uint32_t version;    /* BinaryGraphVersion                    */
+    uint32_t indexWidth; /* bytes per entry of p and i: 4 or 8    */
+    uint32_t flags;      /* BinaryGraph_EdgeWeights and so on     */
+    uint32_t byteOrder;  /* BinaryGraphByteOrder, in native order */
+    int64_t n;           /* # vertices                            */
+    int64_t nz;          /* # edges (entries in i)                */
+    uint64_t reserved[3];
+};
+
+static const char BinaryGraphMagic[8]      = { 'M', 'O', 'N', 'G',
+                                          'O', 'O', 'S', 'E' };
+static const uint32_t BinaryGraphVersion   = 1;
+static const uint32_t BinaryGraphByteOrder = 0x01020304;
+static const uint32_t BinaryGraph_EdgeWeights   = 1;
+static const uint32_t BinaryGraph_VertexWeights = 2;
+
+static inline size_t align8(size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+/* Read count indices of the given width starting at offset, widening them to
+ * Int if needed. */
+static bool readIndices(FILE *file, size_t offset, size_t width, size_t count,
+                        Int *out)
+{
+    if (fseek(file, static_cast<long>(offset), SEEK_SET) != 0)
+        return false;
+    if (width == sizeof(Int))
+        return (fread(out, sizeof(Int), count, file) == count);
+
+    for (size_t k = 0; k < count; k++)
+    {
+        uint32_t index;
+        if (fread(&index, sizeof(index), 1, file) != 1)
+            return false;
+        out[k] = static_cast<Int>(index);
+    }
+    return true;
+}
+
+static bool readDoubles(FILE *file, size_t offset, size_t count, double *out)
+{
+    return (fseek(file, static_cast<long>(offset), SEEK_SET) == 0
+            && fread(out, sizeof(double), count, file) == count);
+}
+
+/* Write count indices at the given width, followed by zero padding up to a
+ * multiple of 8 bytes. */
+static bool writeIndices(FILE *file, const Int *in, size_t count, size_t width)
+{
+    if (width == sizeof(Int))
+    {
+        if (fwrite(in, sizeof(Int), count, file) != count)
+            return false;
+    }
+    else
+    {
+        uint32_t buffer[1024];
+        for (size_t k = 0; k < count; k += 1024)
+        {
+            size_t chunk = std::min(count - k, static_cast<size_t>(1024));
+            for (size_t j = 0; j < chunk; j++)
+                buffer[j] = static_cast<uint32_t>(in[k + j]);
+            if (fwrite(buffer, sizeof(uint32_t), chunk, file) != chunk)
+                return false;
+        }
+    }
+
+    static const char zeros[8] = { 0 };
+    size_t padding = align8(count * width) - count * width;
+    return (fwrite(zeros, 1, padding, file) == padding);
+}
+
+// Read and check the banner and size line of a Matrix Market file.
+static bool readHeader(FILE *file, MM_typecode &matcode, long &N, long &nz)
+{
+    LogInfo("Reading Matrix Market banner...");
+    if (mm_read_banner(file, &matcode) != 0)
+    {
+        LogError("Error: Could not process Matrix Market banner\n");
+        return false;
+    }
+    if (!mm_is_matrix(matcode) || !mm_is_sparse(matcode)
+        || mm_is_complex(matcode))
+    {
+        LogError(
+            "Error: Unsupported matrix format - Must be real and sparse\n");
+        return false;
+    }
+
+    long M;
+    if ((mm_read_mtx_crd_size(file, &M, &N, &nz)) != 0)
+    {
+        LogError("Error: Could not parse matrix dimension and size.\n");
+        return false;
+    }
+    if (M != N)
+    {
+        LogError("Error: Matrix must be square.\n");
+        return false;
+    }
+    return true;
+}
+
+// Open a string as a read-only file, for the mmio header functions.
+static FILE *openText(std::string &text)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    return fmemopen(&text[0], text.size(), "r");
+#else
+    FILE *file = tmpfile();
+    if (file
+        && (fwrite(text.data(), 1, text.size(), file) != text.size()
+            || fseek(file, 0, SEEK_SET) != 0))
+    {
+        fclose(file);
+        file = NULL;
+    }
+    return file;
+#endif
+}
+
+// Read a gzip-compressed Matrix Market file into a triplet matrix, parsing
+// each block of text while the next one is being decompressed.
+static cs *readTripletsGzip(const char *filename, MM_typecode &matcode)
+{
+    GzipStream *stream = GzipStream::create(filename);
+    if (!stream)
+        return NULL;
+
+    // Collect the banner, comments and size line.
+    std::string header;
+    const char *data = NULL, *end = NULL;
+    bool found       = false;
+    while (!found && stream->next(data, end))
+    {
+        while (!found && data < end)
+        {
+            const char *line = data;
+            data             = nextLine(data, end);
+            bool banner      = header.empty();
+            header.append(line, data);
+            found = !banner && *line != '%' && moreOnLine(line, data);
+        }
+    }
+
+    long N = 0, nz = 0;
+    FILE *file = (found) ? openText(header) : NULL;
+    bool ok    = (file && readHeader(file, matcode, N, nz));
+    if (file)
+        fclose(file);
+    if (!ok)
+    {
+        if (stream->failed())
+            LogError("Error: Could not decompress Matrix Market file\n");
+        else if (!found)
+            LogError("Error: Could not read Matrix Market header\n");
+        stream->~GzipStream();
+        return NULL;
+    }
+
+    LogInfo("Reading compressed matrix data...\n");
+    cs *A = cs_spalloc(N, N, nz, 1, 1);
+    if (!A)
+    {
+        LogError("Error: Ran out of memory in Mongoose::readTriplets\n");
+        stream->~GzipStream();
+        return NULL;
+    }
+
+    ok = readMatrixMarketStream(stream, data, end, N, nz, A->i, A->p, A->x,
+                                mm_is_pattern(matcode));
+    stream->~GzipStream();
+    if (!ok)
+    {
+        LogError("Error: Could not read matrix data\n");
+        cs_spfree(A);
+        return NULL;
+    }
+
+    A->nz = nz;
+    return A;
+}
+
+// Read a Matrix Market file, which may be gzip-compressed, into a triplet
+// matrix.
+static cs *readTriplets(const char *filename, MM_typecode &matcode)
+{
+    LogInfo("Reading Matrix from " << std::string(filename) << "\n");
+    FILE *file = fopen(filename, "r");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        return NULL;
+    }
+
+    if (isGzipFile(file))
+    {
+        fclose(file);
+        return readTripletsGzip(filename, matcode);
+    }
+
+    long N, nz;
+    if (!readHeader(file, matcode, N, nz))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    LogInfo("Reading matrix data...\n");
+    cs *A = cs_spalloc(N, N, nz, 1, 1);
+    if (!A)
+    {
+        LogError("Error: Ran out of memory in Mongoose::readTriplets\n");
+        fclose(file);
+        return NULL;
+    }
+
+    bool mapped;
+    bool ok = readMatrixMarketData(file, N, nz, A->i, A->p, A->x,
+                                   mm_is_pattern(matcode), mapped);
+    if (!mapped)
+    {
+        // Memory mapping is not available; read one entry at a time.
+        ok = (mm_read_mtx_crd_data(file, N, N, nz, (long *)A->i, (long *)A->p,
+                                   A->x, matcode)
+              == 0);
+        for (Int k = 0; k < nz; k++)
+        {
+            --A->i[k];
+            --A->p[k];
+            if (mm_is_pattern(matcode))
+                A->x[k] = 1;
+        }
+    }
+    fclose(file); // Close the file
+
+    if (!ok)
+    {
+        LogError("Error: Could not read matrix data\n");
+        cs_spfree(A);
+        return NULL;
+    }
+
+    A->nz = nz;
+    return A;
+}
+
 Graph *read_graph(const std::string &filename)
 {
     return read_graph(filename.c_str());
@@ -39,37 +310,143 @@ cs *read_matrix(const std::string &filename, MM_typecode &matcode)
     return read_matrix(filename.c_str(), matcode);
 }
 
+/* Build a sanitized graph from a triplet matrix, which is consumed, and give
+ * it the vertex weights, if any. */
+static Graph *graphFromTriplets(cs *T, bool symmetricTriangular,
+                                double *vertexWeights)
+{
+    // Build the graph straight from the triplets, which are freed as soon as
+    // they have been bucketed, rather than compressing them first.
+    LogInfo("Building sanitized graph from triplets...\n");
+    cs *sanitized_A = sanitizeTriplets(T, symmetricTriangular, false);
+    if (!sanitized_A)
+    {
+        SuiteSparse_free(vertexWeights);
+        return NULL;
+    }
+
+    Graph *G = Graph::create(sanitized_A, true);
+
+    if (!G)
+    {
+        cs_spfree(sanitized_A);
+        SuiteSparse_free(vertexWeights);
+        return NULL;
+    }
+
+    sanitized_A->p = NULL;
+    sanitized_A->i = NULL;
+    sanitized_A->x = NULL;
+    cs_spfree(sanitized_A);
+
+    G->w = vertexWeights;
+
+    return G;
+}
+
 Graph *read_graph(const char *filename)
 {
+    TraceSpan span("ReadGraph");
     Logger::tic(IOTiming);
     LogInfo("Reading graph from file " << std::string(filename) << "\n");
 
     MM_typecode matcode;
-    cs *A = read_matrix(filename, matcode);
-    if (!A)
+    cs *T = readTriplets(filename, matcode);
+    if (!T)
     {
         LogError("Error reading matrix from file\n");
+        Logger::toc(IOTiming);
         return NULL;
     }
-    cs *sanitized_A = sanitizeMatrix(A, mm_is_symmetric(matcode), false);
-    cs_spfree(A);
-    if (!sanitized_A)
+
+    Graph *G = graphFromTriplets(T, mm_is_symmetric(matcode), NULL);
+    if (!G)
+    {
+        LogError("Ran out of memory in Mongoose::read_graph\n");
+    }
+
+    Logger::toc(IOTiming);
+
+    return G;
+}
+
+Graph *read_graph_metis(const std::string &filename)
+{
+    return read_graph_metis(filename.c_str());
+}
+
+Graph *read_graph_metis(const char *filename)
+{
+    TraceSpan span("ReadGraphMetis");
+    Logger::tic(IOTiming);
+    LogInfo("Reading METIS graph from file " << std::string(filename)
+                                             << "\n");
+
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
         return NULL;
+    }
 
-    Graph *G = Graph::create(sanitized_A, true);
+    double *vertexWeights = NULL;
+    cs *T                 = readMetisTriplets(file, &vertexWeights);
+    fclose(file);
+    if (!T)
+    {
+        Logger::toc(IOTiming);
+        return NULL;
+    }
 
+    // Each edge is listed by both of its endpoints.
+    Graph *G = graphFromTriplets(T, false, vertexWeights);
     if (!G)
     {
-        LogError("Ran out of memory in Mongoose::read_graph\n");
-        cs_spfree(sanitized_A);
+        LogError("Ran out of memory in Mongoose::read_graph_metis\n");
+    }
+
+    Logger::toc(IOTiming);
+
+    return G;
+}
+
+Graph *read_graph_edgelist(const std::string &filename, size_t indexWidth,
+                           bool weighted)
+{
+    return read_graph_edgelist(filename.c_str(), indexWidth, weighted);
+}
+
+Graph *read_graph_edgelist(const char *filename, size_t indexWidth,
+                           bool weighted)
+{
+    TraceSpan span("ReadGraphEdgelist");
+    Logger::tic(IOTiming);
+    LogInfo("Reading edge list from file " << std::string(filename) << "\n");
+
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
         Logger::toc(IOTiming);
         return NULL;
     }
 
-    sanitized_A->p = NULL;
-    sanitized_A->i = NULL;
-    sanitized_A->x = NULL;
-    cs_spfree(sanitized_A);
+    cs *T = readEdgeListTriplets(file, indexWidth, weighted);
+    fclose(file);
+    if (!T)
+    {
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    // Each edge is listed once, so it is mirrored like a symmetric matrix
+    // stored as one triangle.
+    Graph *G = graphFromTriplets(T, true, NULL);
+    if (!G)
+    {
+        LogError("Ran out of memory in Mongoose::read_graph_edgelist\n");
+    }
 
     Logger::toc(IOTiming);
 
@@ -78,99 +455,431 @@ Graph *read_graph(const char *filename)
 
 cs *read_matrix(const char *filename, MM_typecode &matcode)
 {
-    LogInfo("Reading Matrix from " << std::string(filename) << "\n");
-    FILE *file = fopen(filename, "r");
+    cs *A = readTriplets(filename, matcode);
+    if (!A)
+        return NULL;
+
+    LogInfo("Compressing matrix from triplet to CSC format...\n");
+    cs *compressed_A = cs_compress(A);
+    cs_spfree(A);
+    if (!compressed_A)
+    {
+        LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
+        return NULL;
+    }
+
+    return compressed_A;
+}
+
+bool write_graph_binary(const Graph *graph, const std::string &filename,
+                        bool compactIndices)
+{
+    return write_graph_binary(graph, filename.c_str(), compactIndices);
+}
+
+bool write_graph_binary(const Graph *graph, const char *filename,
+                        bool compactIndices)
+{
+    if (!graph)
+    {
+        LogError("Error: Cannot write a NULL graph\n");
+        return false;
+    }
+
+    TraceSpan span("WriteGraphBinary");
+    Logger::tic(IOTiming);
+    LogInfo("Writing binary graph to file " << std::string(filename) << "\n");
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        LogError("Error: Cannot write file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return false;
+    }
+
+    size_t n  = static_cast<size_t>(graph->n);
+    size_t nz = static_cast<size_t>(graph->nz);
+
+    BinaryGraphHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BinaryGraphMagic, sizeof(BinaryGraphMagic));
+    header.version    = BinaryGraphVersion;
+    header.indexWidth = sizeof(Int);
+    if (compactIndices && n <= UINT32_MAX && nz <= UINT32_MAX)
+    {
+        header.indexWidth = sizeof(uint32_t);
+    }
+    header.flags = ((graph->x) ? BinaryGraph_EdgeWeights : 0)
+                   | ((graph->w) ? BinaryGraph_VertexWeights : 0);
+    header.byteOrder = BinaryGraphByteOrder;
+    header.n         = static_cast<int64_t>(n);
+    header.nz        = static_cast<int64_t>(nz);
+
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1)
+              && writeIndices(file, graph->p, n + 1, header.indexWidth)
+              && writeIndices(file, graph->i, nz, header.indexWidth)
+              && (!graph->x
+                  || fwrite(graph->x, sizeof(double), nz, file) == nz)
+              && (!graph->w
+                  || fwrite(graph->w, sizeof(double), n, file) == n);
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        LogError("Error: Could not write binary graph file\n");
+    }
+
+    Logger::toc(IOTiming);
+
+    return ok;
+}
+
+Graph *read_graph_binary(const std::string &filename)
+{
+    return read_graph_binary(filename.c_str());
+}
+
+Graph *read_graph_binary(const char *filename)
+{
+    TraceSpan span("ReadGraphBinary");
+    Logger::tic(IOTiming);
+    LogInfo("Reading binary graph from file " << std::string(filename)
+                                              << "\n");
+
+    FILE *file = fopen(filename, "rb");
     if (!file)
     {
         LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
         return NULL;
     }
 
-    LogInfo("Reading Matrix Market banner...");
-    if (mm_read_banner(file, &matcode) != 0)
+    BinaryGraphHeader header;
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < static_cast<long>(sizeof(header))
+        || fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, BinaryGraphMagic, sizeof(BinaryGraphMagic))
+               != 0)
     {
-        LogError("Error: Could not process Matrix Market banner\n");
+        LogError("Error: Not a Mongoose binary graph file\n");
         fclose(file);
+        Logger::toc(IOTiming);
         return NULL;
     }
-    if (!mm_is_matrix(matcode) || !mm_is_sparse(matcode)
-        || mm_is_complex(matcode))
+    if (header.version > BinaryGraphVersion
+        || header.byteOrder != BinaryGraphByteOrder
+        || (header.indexWidth != 4 && header.indexWidth != 8)
+        || header.indexWidth > sizeof(Int) || header.n < 0 || header.nz < 0)
     {
-        LogError(
-            "Error: Unsupported matrix format - Must be real and sparse\n");
+        LogError("Error: Unsupported binary graph version, byte order or "
+                 "index width\n");
         fclose(file);
+        Logger::toc(IOTiming);
         return NULL;
     }
 
-    long M, N, nz;
-    if ((mm_read_mtx_crd_size(file, &M, &N, &nz)) != 0)
+    size_t n     = static_cast<size_t>(header.n);
+    size_t nz    = static_cast<size_t>(header.nz);
+    size_t width = header.indexWidth;
+
+    // Sizes that could not fit in the file are rejected before the layout
+    // is computed, so that none of its products can overflow.
+    size_t capacity = static_cast<size_t>(fileSize) / width;
+    if (n >= capacity || nz >= capacity)
     {
-        LogError("Error: Could not parse matrix dimension and size.\n");
+        LogError("Error: Binary graph file is truncated\n");
         fclose(file);
+        Logger::toc(IOTiming);
         return NULL;
     }
-    if (M != N)
+
+    bool hasX     = (header.flags & BinaryGraph_EdgeWeights) != 0;
+    bool hasW     = (header.flags & BinaryGraph_VertexWeights) != 0;
+    size_t pStart = sizeof(header);
+    size_t iStart = pStart + align8((n + 1) * width);
+    size_t xStart = iStart + align8(nz * width);
+    size_t wStart = xStart + ((hasX) ? nz * sizeof(double) : 0);
+    size_t total  = wStart + ((hasW) ? n * sizeof(double) : 0);
+    if (static_cast<size_t>(fileSize) < total)
     {
-        LogError("Error: Matrix must be square.\n");
+        LogError("Error: Binary graph file is truncated\n");
         fclose(file);
+        Logger::toc(IOTiming);
         return NULL;
     }
 
-    LogInfo("Reading matrix data...\n");
-    Int *I = (Int *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(Int));
-    Int *J = (Int *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(Int));
-    double *val
-        = (double *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(double));
+    Graph *graph = NULL;
+#ifdef MONGOOSE_HAVE_MMAP
+    void *map = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                     fileno(file), 0);
+    if (map != MAP_FAILED)
+    {
+        // Indices stored at the native width are used in place; narrower
+        // ones are widened into arrays owned by the Graph.
+        char *data  = static_cast<char *>(map);
+        bool native = (width == sizeof(Int));
+        graph       = Graph::create(
+            static_cast<Int>(n), static_cast<Int>(nz),
+            (native) ? (Int *)(data + pStart) : NULL,
+            (native) ? (Int *)(data + iStart) : NULL,
+            (hasX) ? (double *)(data + xStart) : NULL,
+            (hasW) ? (double *)(data + wStart) : NULL);
+        if (!graph)
+        {
+            munmap(map, total);
+        }
+        else
+        {
+            graph->mapping     = map;
+            graph->mappingSize = total;
+            if (!native)
+            {
+                const uint32_t *p32 = (const uint32_t *)(data + pStart);
+                const uint32_t *i32 = (const uint32_t *)(data + iStart);
+                for (size_t k = 0; k <= n; k++)
+                    graph->p[k] = static_cast<Int>(p32[k]);
+                for (size_t k = 0; k < nz; k++)
+                    graph->i[k] = static_cast<Int>(i32[k]);
+            }
+        }
+    }
+    else
+#endif
+    {
+        // No memory mapping; read each array into its own allocation.
+        graph = Graph::create(static_cast<Int>(n), static_cast<Int>(nz));
+        if (graph)
+        {
+            if (hasX)
+                graph->x = (double *)SuiteSparse_malloc(nz, sizeof(double));
+            if (hasW)
+                graph->w = (double *)SuiteSparse_malloc(n, sizeof(double));
+            if ((hasX && !graph->x) || (hasW && !graph->w)
+                || !readIndices(file, pStart, width, n + 1, graph->p)
+                || !readIndices(file, iStart, width, nz, graph->i)
+                || (hasX && !readDoubles(file, xStart, nz, graph->x))
+                || (hasW && !readDoubles(file, wStart, n, graph->w)))
+            {
+                graph->~Graph();
+                graph = NULL;
+            }
+        }
+    }
+    fclose(file);
 
-    if (!I || !J || !val)
+    if (!graph)
     {
-        LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
-        SuiteSparse_free(I);
-        SuiteSparse_free(J);
-        SuiteSparse_free(val);
-        fclose(file);
+        LogError("Error: Could not load binary graph file\n");
+        Logger::toc(IOTiming);
         return NULL;
     }
 
-    mm_read_mtx_crd_data(file, M, N, nz, (long*)I, (long*)J, val, matcode);
-    fclose(file); // Close the file
+    // Check the structure once, so that later passes can trust p and i.
+    bool valid = (graph->p[0] == 0 && graph->p[n] == static_cast<Int>(nz));
+    for (size_t k = 0; valid && k < n; k++)
+        valid = (graph->p[k] <= graph->p[k + 1]);
+    for (size_t k = 0; valid && k < nz; k++)
+        valid = (graph->i[k] >= 0 && graph->i[k] < static_cast<Int>(n));
+    if (!valid)
+    {
+        LogError("Error: Binary graph file is corrupt\n");
+        graph->~Graph();
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    Logger::toc(IOTiming);
+
+    return graph;
+}
+
+/* Mongoose binary partition file header, followed by one bit per vertex
+ * (vertex k is bit k % 8 of byte k / 8), padded to a multiple of 8 bytes,
+ * and then by the 64-bit original vertex of each entry if the partition
+ * covers only part of a graph. */
+struct BinaryPartitionHeader
+{
+    char magic[8];      /* "MONGPART"                            */
+    uint32_t version;   /* BinaryPartitionVersion                */
+    uint32_t flags;     /* BinaryPartition_VertexMap             */
+    uint32_t byteOrder; /* BinaryGraphByteOrder, in native order */
+    uint32_t reserved;
+    int64_t n; /* # vertices in the partition */
+};
+
+static const char BinaryPartitionMagic[8]    = { 'M', 'O', 'N', 'G',
+                                              'P', 'A', 'R', 'T' };
+static const uint32_t BinaryPartitionVersion = 1;
+static const uint32_t BinaryPartition_VertexMap = 1;
+
+/* Output is formatted into a large buffer, which is written with a single
+ * fwrite whenever it fills up. */
+static const size_t OutputBufferSize = 1 << 20;
+
+struct OutputBuffer
+{
+    FILE *file;
+    char *data;
+    size_t length;
+    bool ok;
+};
 
-    for (Int k = 0; k < nz; k++)
+static void flushOutput(OutputBuffer &out)
+{
+    out.ok
+        = out.ok && (fwrite(out.data, 1, out.length, out.file) == out.length);
+    out.length = 0;
+}
+
+/* Append a non-negative integer and a separator. */
+static inline void putIndex(OutputBuffer &out, Int value, char separator)
+{
+    if (out.length + 24 > OutputBufferSize)
+        flushOutput(out);
+
+    char digits[20];
+    int d = 0;
+    do
     {
-        --I[k];
-        --J[k];
-        if (mm_is_pattern(matcode))
-            val[k] = 1;
+        digits[d++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (d > 0)
+        out.data[out.length++] = digits[--d];
+    out.data[out.length++] = separator;
+}
+
+static inline Int originalVertex(const EdgeCut *cut, Int k)
+{
+    return (cut->vertex_map) ? cut->vertex_map[k] : k;
+}
+
+static void writePartitionBinary(const EdgeCut *cut, OutputBuffer &out)
+{
+    BinaryPartitionHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BinaryPartitionMagic, sizeof(BinaryPartitionMagic));
+    header.version   = BinaryPartitionVersion;
+    header.flags     = (cut->vertex_map) ? BinaryPartition_VertexMap : 0;
+    header.byteOrder = BinaryGraphByteOrder;
+    header.n         = static_cast<int64_t>(cut->n);
+    memcpy(out.data, &header, sizeof(header));
+    out.length = sizeof(header);
+
+    size_t n     = static_cast<size_t>(cut->n);
+    size_t bytes = align8((n + 7) / 8);
+    for (size_t b = 0; b < bytes; b++)
+    {
+        if (out.length == OutputBufferSize)
+            flushOutput(out);
+        unsigned char bits = 0;
+        for (size_t k = 8 * b; k < std::min(8 * b + 8, n); k++)
+        {
+            if (cut->partition[k])
+                bits |= static_cast<unsigned char>(1 << (k % 8));
+        }
+        out.data[out.length++] = static_cast<char>(bits);
     }
 
-    cs *A = (cs *)SuiteSparse_malloc(1, sizeof(cs));
-    if (!A)
+    if (cut->vertex_map)
     {
-        LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
-        SuiteSparse_free(I);
-        SuiteSparse_free(J);
-        SuiteSparse_free(val);
-        return NULL;
+        for (size_t k = 0; k < n; k++)
+        {
+            if (out.length + sizeof(int64_t) > OutputBufferSize)
+                flushOutput(out);
+            int64_t vertex = static_cast<int64_t>(cut->vertex_map[k]);
+            memcpy(out.data + out.length, &vertex, sizeof(vertex));
+            out.length += sizeof(vertex);
+        }
     }
+}
 
-    A->nzmax = nz;
-    A->m     = M;
-    A->n     = N;
-    A->p     = J;
-    A->i     = I;
-    A->x     = val;
-    A->nz    = nz;
+bool write_partition(const EdgeCut *cut, const std::string &filename,
+                     PartitionFormat format)
+{
+    return write_partition(cut, filename.c_str(), format);
+}
 
-    LogInfo("Compressing matrix from triplet to CSC format...\n");
-    cs *compressed_A = cs_compress(A);
-    cs_spfree(A);
-    if (!compressed_A)
+bool write_partition(const EdgeCut *cut, const char *filename,
+                     PartitionFormat format)
+{
+    TraceSpan span("WritePartition");
+    Logger::tic(IOTiming);
+    LogInfo("Writing partition to file " << std::string(filename) << "\n");
+
+    const char *mode = (format == PartitionFormat_Binary) ? "wb" : "w";
+    FILE *file       = fopen(filename, mode);
+    if (!file)
     {
-        LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
-        return NULL;
+        LogError("Error: Cannot write file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return false;
     }
 
-    return compressed_A;
+    bool ok = write_partition(cut, file, format);
+    ok      = (fclose(file) == 0) && ok;
+
+    Logger::toc(IOTiming);
+
+    return ok;
+}
+
+bool write_partition(const EdgeCut *cut, FILE *file, PartitionFormat format)
+{
+    if (!cut || !file)
+    {
+        LogError("Error: Cannot write a NULL partition\n");
+        return false;
+    }
+
+    OutputBuffer out;
+    out.file   = file;
+    out.data   = (char *)SuiteSparse_malloc(OutputBufferSize, 1);
+    out.length = 0;
+    out.ok     = (out.data != NULL);
+    if (!out.ok)
+    {
+        LogError("Error: Ran out of memory in Mongoose::write_partition\n");
+        return false;
+    }
+
+    switch (format)
+    {
+    case PartitionFormat_Text:
+        for (Int k = 0; k < cut->n; k++)
+        {
+            putIndex(out, originalVertex(cut, k), ' ');
+            putIndex(out, (cut->partition[k]) ? 1 : 0, '\n');
+        }
+        break;
+
+    case PartitionFormat_Binary:
+        writePartitionBinary(cut, out);
+        break;
+
+    case PartitionFormat_Permutation:
+        for (int part = 0; part < 2; part++)
+        {
+            for (Int k = 0; k < cut->n; k++)
+            {
+                if (cut->partition[k] == (part == 1))
+                    putIndex(out, originalVertex(cut, k), '\n');
+            }
+        }
+        break;
+    }
+    flushOutput(out);
+    SuiteSparse_free(out.data);
+
+    if (!out.ok)
+    {
+        LogError("Error: Could not write partition\n");
+    }
+
+    return out.ok;
 }
 
 } // end namespace Mongoose
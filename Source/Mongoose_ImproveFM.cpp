@@ -14,6 +14,8 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_OpCounters.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
@@ -23,11 +25,14 @@ namespace Mongoose
 //-----------------------------------------------------------------------------
 void improveCutUsingFM(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
-    Logger::tic(FMTiming);
+    TraceSpan span("FM", graph->clevel);
+    Logger::tic(FMTiming, graph->clevel);
 
     if (!options->use_FM)
         return;
 
+    int64_t start = (options->collect_stats) ? Trace::now() : 0;
+
     double heuCost = INFINITY;
     for (Int i = 0;
          i < options->FM_max_num_refinements && graph->heuCost < heuCost; i++)
@@ -36,6 +41,9 @@ void improveCutUsingFM(EdgeCutProblem *graph, const EdgeCut_Options *options)
         fmRefine_worker(graph, options);
     }
 
+    if (options->collect_stats)
+        graph->stats.fm_time += (Trace::now() - start) / 1e9;
+
     Logger::toc(FMTiming);
 }
 
@@ -207,6 +215,10 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
     // clear the marks from all the vertices
     graph->clearMarkArray();
 
+    graph->stats.fm_passes++;
+    graph->stats.fm_moves += head;
+    graph->stats.fm_rollbacks += tail - head;
+
     /* Save the best cost back into the graph. */
     graph->heuCost   = bestCost.heuCost;
     graph->cutCost   = bestCost.cutCost;
@@ -242,6 +254,7 @@ void fmSwap(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex, d
         Int neighbor           = Gi[p];
         bool neighborPartition = partition[neighbor];
         bool sameSide          = (newPartition == neighborPartition);
+        MONGOOSE_COUNT(NeighborUpdateOp);
 
         /* Update the bestCandidate vertex's external degree. */
         if (!sameSide)
@@ -304,6 +317,8 @@ void calculateGain(EdgeCutProblem *graph, const EdgeCut_Options *options, Int ve
 {
     (void)options; // Unused variable
 
+    MONGOOSE_COUNT(GainCalculationOp);
+
     Int *Gp         = graph->p;
     Int *Gi         = graph->i;
     double *Gx      = graph->x;
@@ -18,32 +18,20 @@
 #include "Mongoose_QPBoundary.hpp"
 #include "Mongoose_QPLinks.hpp"
 #include "Mongoose_QPNapsack.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
 
-bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bool isInitial)
+/* Set the QP bounds, convert the guess from discrete to continuous, and
+ * build the FreeSet.  Returns false if QPLinks fails. */
+template <typename Float>
+static bool initializeQP(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                         QPDeltaT<Float> *QP, bool isInitial)
 {
-    if (!options->use_QP_gradproj)
-        return false;
-
-    Logger::tic(QPTiming);
-
-    /* Unpack structure fields */
-    Int n               = graph->n;
-    Int *Gp             = graph->p;
-    double *Gx          = graph->x; // edge weights
-    double *Gw          = graph->w; // vertex weights
-    double *gains       = graph->vertexGains;
-    Int *externalDegree = graph->externalDegree;
-
-    /* create workspaces */
-    QPDelta *QP = QPDelta::Create(n);
-    if (!QP)
-    {
-        Logger::toc(QPTiming);
-        return false;
-    }
+    Int n      = graph->n;
+    Int *Gp    = graph->p;
+    double *Gx = graph->x; // edge weights
 
     // set the QP parameters
     double tol         = options->soft_split_tolerance;
@@ -61,15 +49,22 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     QP->hi = graph->W * std::min(1., targetSplit + tol);
     ASSERT(QP->lo <= QP->hi);
 
-    /* Convert the guess from discrete to continuous. */
-    double *D       = QP->D;
-    double *guess   = QP->x;
+    /* Convert the guess from discrete to continuous.  If a continuous
+     * solution was prolonged from the coarser level, start from it wherever
+     * it still agrees with the discrete partition. */
+    Float *D        = QP->D;
+    Float *guess    = QP->x;
     bool *partition = graph->partition;
+    double *warmX   = graph->qpSolution;
     for (Int k = 0; k < n; k++)
     {
         if (isInitial)
         {
-            guess[k] = targetSplit;
+            guess[k] = static_cast<Float>(targetSplit);
+        }
+        else if (warmX && (warmX[k] > 0.5) == partition[k])
+        {
+            guess[k] = static_cast<Float>(warmX[k]);
         }
         else
         {
@@ -87,7 +82,7 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
         {
             maxWeight = std::max(maxWeight, (Gx) ? Gx[p] : 1);
         }
-        D[k] = maxWeight;
+        D[k] = static_cast<Float>(maxWeight);
     }
 
     // lo <= a'x <= hi might not hold here
@@ -101,20 +96,127 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     }
 
     // Build the FreeSet, compute grad, possibly adjust QP->lo and QP->hi
-    if (!QPLinks(graph, options, QP))
+    // lo <= a'x <= hi then holds (lo and hi are modified as needed in QPLinks)
+    return QPLinks(graph, options, QP);
+}
+
+/* Solve the QP in single precision, then polish the result with one pass of
+ * gradient projection in double precision.  Returns the double precision
+ * workspace holding the final x, or NULL on failure. */
+static QPDelta *solveQPMixedPrecision(EdgeCutProblem *graph,
+                                      const EdgeCut_Options *options,
+                                      bool isInitial)
+{
+    Int n = graph->n;
+
+    QPDeltaSingle *QPs = QPDeltaSingle::Create(n);
+    if (!QPs)
+        return NULL;
+
+    QPDelta *QP = NULL;
+    if (initializeQP(graph, options, QPs, isInitial))
     {
-        Logger::toc(QPTiming);
-        return false;
+        QPGradProj(graph, options, QPs);
+        QPBoundary(graph, options, QPs);
+        QPGradProj(graph, options, QPs);
+        QPBoundary(graph, options, QPs);
+
+        QP = QPDelta::Create(n);
     }
 
-    // lo <= a'x <= hi now holds (lo and hi are modified as needed in QPLinks)
+    if (QP)
+    {
+        /* Promote the single precision solution as the starting guess. */
+        QP->lo = QPs->lo;
+        QP->hi = QPs->hi;
+        for (Int k = 0; k < n; k++)
+        {
+            QP->x[k] = QPs->x[k];
+            QP->D[k] = QPs->D[k];
+        }
+    }
+
+    QPs->~QPDeltaSingle();
+    SuiteSparse_free(QPs);
+
+    if (!QP)
+        return NULL;
+
+    // Rebuild the FreeSet and gradient in double precision.  Any rounding
+    // that left a'x slightly outside [lo,hi] is absorbed by QPLinks.
+    if (!QPLinks(graph, options, QP))
+    {
+        QP->~QPDelta();
+        SuiteSparse_free(QP);
+        return NULL;
+    }
 
-    /* Do one run of gradient projection. */
-    QPGradProj(graph, options, QP);
-    QPBoundary(graph, options, QP);
     QPGradProj(graph, options, QP);
     QPBoundary(graph, options, QP);
 
+    return QP;
+}
+
+bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bool isInitial)
+{
+    if (!options->use_QP_gradproj)
+        return false;
+
+    TraceSpan span("QP", graph->clevel);
+    Logger::tic(QPTiming, graph->clevel);
+    int64_t start = (options->collect_stats) ? Trace::now() : 0;
+
+    /* Unpack structure fields */
+    Int n               = graph->n;
+    double *Gw          = graph->w; // vertex weights
+    double *gains       = graph->vertexGains;
+    Int *externalDegree = graph->externalDegree;
+    bool *partition     = graph->partition;
+    double targetSplit  = options->target_split;
+
+    QPDelta *QP = NULL;
+    if (options->use_QP_single_precision)
+    {
+        QP = solveQPMixedPrecision(graph, options, isInitial);
+        if (!QP)
+        {
+            Logger::toc(QPTiming);
+            return false;
+        }
+    }
+    else
+    {
+        /* create workspaces */
+        QP = QPDelta::Create(n);
+        if (!QP)
+        {
+            Logger::toc(QPTiming);
+            return false;
+        }
+
+        if (!initializeQP(graph, options, QP, isInitial))
+        {
+            Logger::toc(QPTiming);
+            return false;
+        }
+
+        /* Do one run of gradient projection. */
+        QPGradProj(graph, options, QP);
+        QPBoundary(graph, options, QP);
+        QPGradProj(graph, options, QP);
+        QPBoundary(graph, options, QP);
+    }
+    double *guess = QP->x;
+
+    /* Keep the continuous solution so refine can prolong it to the next
+     * finer level. */
+    if (options->use_QP_prolongation)
+    {
+        SuiteSparse_free(graph->qpSolution);
+        graph->qpSolution = QP->x;
+        QP->x             = NULL;
+    }
+
     /* Use the CutCost to keep track of impacts to the cut cost. */
     CutCost cost;
     cost.cutCost   = graph->cutCost;
@@ -175,6 +277,9 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
                             ? absImbalance * graph->H
                             : 0.0);
 
+    if (options->collect_stats)
+        graph->stats.qp_time += (Trace::now() - start) / 1e9;
+
     Logger::toc(QPTiming);
 
     return true;
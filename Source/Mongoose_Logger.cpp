@@ -28,8 +28,8 @@ namespace Mongoose
 
 int Logger::debugLevel = None;
 bool Logger::timingOn  = false;
-clock_t Logger::clocks[6];
-float Logger::times[6];
+thread_local std::chrono::steady_clock::time_point Logger::clocks[6];
+thread_local float Logger::times[6];
 
 void Logger::setDebugLevel(int debugType)
 {
@@ -15,13 +15,17 @@
  * During coarsening, a matching of vertices is computed to determine
  * which vertices are combined together into supervertices. This can be done
  * using a number of different strategies, including Heavy Edge Matching and
- * Community/Brotherly (similar to 2-hop) Matching.
+ * Community/Brotherly (similar to 2-hop) Matching. If graph->keepSides is set,
+ * only vertices on the same side of the partition are matched, so that the
+ * coarse graph can inherit the partition. The same holds for the second
+ * partition graph->crossSides, if any.
  */
 
 #include "Mongoose_Matching.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
@@ -31,7 +35,8 @@ namespace Mongoose
 //-----------------------------------------------------------------------------
 void match(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
-    Logger::tic(MatchingTiming);
+    TraceSpan span("Matching", graph->clevel);
+    Logger::tic(MatchingTiming, graph->clevel);
     switch (options->matching_strategy)
     {
     case Random:
@@ -79,6 +84,10 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
                 {
                     graph->singleton = k;
                 }
+                else if (!graph->canMatch(k, graph->singleton))
+                {
+                    graph->createMatch(k, k, MatchType_Orphan);
+                }
                 else
                 {
                     graph->createMatch(k, graph->singleton, MatchType_Standard);
@@ -88,14 +97,17 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
             else
             {
                 // Not a singleton
+                Int i = graph->n;
                 if (options->do_community_matching)
                 {
-                    int i;
                     for (i = 0; i < graph->n; i++)
                     {
                         if (graph->matchtype[i] != MatchType_Community)
                             break;
                     }
+                }
+                if (i < graph->n && graph->canMatch(i, k))
+                {
                     graph->createCommunityMatch(i, k, MatchType_Community);
                 }
                 else
@@ -110,14 +122,17 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
     {
         // Leftover singleton
         Int k = graph->singleton;
+        Int i = graph->n;
         if (options->do_community_matching)
         {
-            int i;
             for (i = 0; i < graph->n; i++)
             {
                 if (graph->matchtype[i] != MatchType_Community)
                     break;
             }
+        }
+        if (i < graph->n && graph->canMatch(i, k))
+        {
             graph->createCommunityMatch(i, k, MatchType_Community);
         }
         else
@@ -203,7 +218,7 @@ void matching_Random(EdgeCutProblem *graph, const EdgeCut_Options *options)
             Int neighbor = Gi[p];
 
             /* Consider only unmatched neighbors */
-            if (graph->isMatched(neighbor))
+            if (graph->isMatched(neighbor) || !graph->canMatch(k, neighbor))
                 continue;
 
             unmatched = false;
@@ -225,12 +240,61 @@ void matching_Random(EdgeCutProblem *graph, const EdgeCut_Options *options)
         /* Check condition 2 */
         for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            ASSERT(graph->matching[Gi[p]]);
+            ASSERT(graph->matching[Gi[p]] || !graph->canMatch(k, Gi[p]));
         }
     }
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// Matches the unmatched neighbors of a hub vertex with each other in pairs
+//-----------------------------------------------------------------------------
+static void matchBrothers(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                          Int hub)
+{
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    /* One unpaired neighbor per pair of sides of the partition and of
+     * crossSides, or a single one in group 0 if any two may be matched. */
+    Int v[4] = { -1, -1, -1, -1 };
+    for (Int p = Gp[hub]; p < Gp[hub + 1]; p++)
+    {
+        Int neighbor = Gi[p];
+        if (graph->isMatched(neighbor))
+            continue;
+
+        Int side = (graph->keepSides) ? graph->partition[neighbor] : 0;
+        if (graph->crossSides)
+            side += 2 * graph->crossSides[neighbor];
+        if (v[side] == -1)
+        {
+            v[side] = neighbor;
+        }
+        else
+        {
+            graph->createMatch(v[side], neighbor, MatchType_Brotherly);
+            v[side] = -1;
+        }
+    }
+
+    /* If we had a vertex left over: */
+    for (Int side = 0; side < 4; side++)
+    {
+        if (v[side] == -1)
+            continue;
+
+        if (options->do_community_matching && graph->canMatch(hub, v[side]))
+        {
+            graph->createCommunityMatch(hub, v[side], MatchType_Community);
+        }
+        else
+        {
+            graph->createMatch(v[side], v[side], MatchType_Orphan);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // This is the implementation of stall-reducing matching
 //-----------------------------------------------------------------------------
@@ -250,7 +314,7 @@ void matching_SR(EdgeCutProblem *graph, const EdgeCut_Options *options)
             continue;
         for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            ASSERT(graph->isMatched(Gi[p]));
+            ASSERT(graph->isMatched(Gi[p]) || !graph->canMatch(k, Gi[p]));
         }
     }
 #endif
@@ -280,38 +344,7 @@ void matching_SR(EdgeCutProblem *graph, const EdgeCut_Options *options)
         /* If we found a heaviest neighbor then begin resolving matches. */
         if (heaviestNeighbor != -1)
         {
-            Int v = -1;
-            for (Int p = Gp[heaviestNeighbor]; p < Gp[heaviestNeighbor + 1];
-                 p++)
-            {
-                Int neighbor = Gi[p];
-                if (graph->isMatched(neighbor))
-                    continue;
-
-                if (v == -1)
-                {
-                    v = neighbor;
-                }
-                else
-                {
-                    graph->createMatch(v, neighbor, MatchType_Brotherly);
-                    v = -1;
-                }
-            }
-
-            /* If we had a vertex left over: */
-            if (v != -1)
-            {
-                if (options->do_community_matching)
-                {
-                    graph->createCommunityMatch(heaviestNeighbor, v,
-                                                MatchType_Community);
-                }
-                else
-                {
-                    graph->createMatch(v, v, MatchType_Orphan);
-                }
-            }
+            matchBrothers(graph, options, heaviestNeighbor);
         }
     }
 }
@@ -324,7 +357,6 @@ void matching_SRdeg(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     Int n   = graph->n;
     Int *Gp = graph->p;
-    Int *Gi = graph->i;
 
     /* The brotherly threshold is the minimum degree a "high degree" vertex.
      * It is the options->degreeThreshold times the average degree. */
@@ -334,13 +366,14 @@ void matching_SRdeg(EdgeCutProblem *graph, const EdgeCut_Options *options)
 #ifndef NDEBUG
     /* In order for us to use Passive-Aggressive matching,
      * all unmatched vertices must have matched neighbors. */
+    Int *Gi = graph->i;
     for (Int k = 0; k < n; k++)
     {
         if (graph->isMatched(k))
             continue;
         for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            ASSERT(graph->isMatched(Gi[p]));
+            ASSERT(graph->isMatched(Gi[p]) || !graph->canMatch(k, Gi[p]));
         }
     }
 #endif
@@ -354,36 +387,7 @@ void matching_SRdeg(EdgeCutProblem *graph, const EdgeCut_Options *options)
         Int degree = Gp[k + 1] - Gp[k];
         if (degree >= (Int)bt)
         {
-            Int v = -1;
-            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
-            {
-                Int neighbor = Gi[p];
-                if (graph->isMatched(neighbor))
-                    continue;
-
-                if (v == -1)
-                {
-                    v = neighbor;
-                }
-                else
-                {
-                    graph->createMatch(v, neighbor, MatchType_Brotherly);
-                    v = -1;
-                }
-            }
-
-            /* If we had a vertex left over: */
-            if (v != -1)
-            {
-                if (options->do_community_matching)
-                {
-                    graph->createCommunityMatch(k, v, MatchType_Community);
-                }
-                else
-                {
-                    graph->createMatch(v, v, MatchType_Orphan);
-                }
-            }
+            matchBrothers(graph, options, k);
         }
     }
 
@@ -415,7 +419,7 @@ void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
             Int neighbor = Gi[p];
 
             /* Consider only unmatched neighbors */
-            if (graph->isMatched(neighbor))
+            if (graph->isMatched(neighbor) || !graph->canMatch(k, neighbor))
                 continue;
 
             /* Keep track of the heaviest. */
@@ -448,7 +452,7 @@ void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
         /* Check condition 2 */
         for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            ASSERT(graph->matching[Gi[p]]);
+            ASSERT(graph->matching[Gi[p]] || !graph->canMatch(k, Gi[p]));
         }
     }
 #endif
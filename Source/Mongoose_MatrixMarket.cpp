@@ -0,0 +1,188 @@
+/* ========================================================================== */
+/* === Source/Mongoose_MatrixMarket.cpp ===================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Fast parallel reader for the data section of a Matrix Market file
+ *
+ * The data section is parsed in two passes over the memory mapped file. The
+ * first pass counts the entries in each line-aligned chunk, which gives each
+ * chunk its offset into the triplet arrays. The second pass parses the chunks
+ * concurrently, each writing straight into its own slice of I, J and val.
+ *
+ * A gzip-compressed file is parsed the same way, one decompressed block at a
+ * time, while the next block is decompressed on another thread.
+ */
+
+#include "Mongoose_MatrixMarket.hpp"
+#include "Mongoose_Gzip.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_Parse.hpp"
+
+namespace Mongoose
+{
+
+namespace
+{
+
+/* Chunks smaller than this are not worth a thread of their own. */
+const size_t MinChunkSize = 1 << 20;
+
+/* Count the lines that are not blank. */
+void countChunk(Chunk *chunk)
+{
+    const char *s   = chunk->begin;
+    const char *end = chunk->end;
+    Int count       = 0;
+    while (s < end)
+    {
+        if (moreOnLine(s, end))
+            count++;
+        s = nextLine(s, end);
+    }
+    chunk->count = count;
+}
+
+void parseChunk(Chunk *chunk, Int n, Int *I, Int *J, double *val,
+                bool pattern)
+{
+    const char *s   = chunk->begin;
+    const char *end = chunk->end;
+    Int k           = chunk->offset;
+    Int last        = chunk->offset + chunk->count;
+
+    chunk->ok = true;
+    while (s < end)
+    {
+        if (moreOnLine(s, end))
+        {
+            Int i, j;
+            double x = 1;
+            if (k >= last || !parseIndex(s, end, i) || !parseIndex(s, end, j)
+                || (!pattern && !parseValue(s, end, x)) || i < 1 || i > n
+                || j < 1 || j > n)
+            {
+                chunk->ok = false;
+                return;
+            }
+            I[k]   = i - 1;
+            J[k]   = j - 1;
+            val[k] = x;
+            k++;
+        }
+        s = nextLine(s, end);
+    }
+}
+
+/* Count and parse the entries in [data, end), placing the first at offset
+ * total.  Returns the number of entries, or -1 if there are more than nz in
+ * all or any of them is invalid. */
+Int parseBlock(const char *data, const char *end, Int total, Int n, Int nz,
+               Int *I, Int *J, double *val, bool pattern)
+{
+    std::vector<Chunk> chunks;
+    splitLines(data, end, MinChunkSize, chunks);
+    size_t numThreads = chunks.size();
+    runThreads(numThreads, [&](size_t t) { countChunk(&chunks[t]); });
+
+    Int count = chunkOffsets(chunks);
+    if (count > nz - total)
+        return -1;
+    for (size_t t = 0; t < numThreads; t++)
+        chunks[t].offset += total;
+
+    runThreads(numThreads, [&](size_t t) {
+        parseChunk(&chunks[t], n, I, J, val, pattern);
+    });
+    for (size_t t = 0; t < numThreads; t++)
+    {
+        if (!chunks[t].ok)
+            return -1;
+    }
+    return count;
+}
+
+} // end anonymous namespace
+
+bool readMatrixMarketData(FILE *file, Int n, Int nz, Int *I, Int *J,
+                          double *val, bool pattern, bool &mapped)
+{
+    MappedFile map;
+    mapped = mapFile(file, map);
+    if (!mapped)
+        return false;
+
+    /* Split the data into line-aligned chunks. */
+    std::vector<Chunk> chunks;
+    splitLines(map.data, map.end, MinChunkSize, chunks);
+    size_t numThreads = chunks.size();
+
+    /* Pass 1: count the entries in each chunk. */
+    runThreads(numThreads, [&](size_t t) { countChunk(&chunks[t]); });
+
+    Int total = chunkOffsets(chunks);
+    bool ok   = (total == nz);
+    if (!ok)
+    {
+        LogError("Error: Expected " << nz << " entries in the file but found "
+                                    << total << "\n");
+    }
+    else
+    {
+        /* Pass 2: parse the chunks into their slices of I, J and val. */
+        runThreads(numThreads, [&](size_t t) {
+            parseChunk(&chunks[t], n, I, J, val, pattern);
+        });
+
+        for (size_t t = 0; t < numThreads; t++)
+            ok = ok && chunks[t].ok;
+        if (!ok)
+        {
+            LogError("Error: Invalid entry in Matrix Market file\n");
+        }
+    }
+
+    unmapFile(map);
+    return ok;
+}
+
+bool readMatrixMarketStream(GzipStream *stream, const char *data,
+                            const char *end, Int n, Int nz, Int *I, Int *J,
+                            double *val, bool pattern)
+{
+    Int total = 0;
+    do
+    {
+        Int count = parseBlock(data, end, total, n, nz, I, J, val, pattern);
+        if (count < 0)
+        {
+            LogError("Error: Invalid entry or too many entries in Matrix "
+                     "Market file\n");
+            return false;
+        }
+        total += count;
+    } while (stream->next(data, end));
+
+    if (stream->failed())
+    {
+        LogError("Error: Could not decompress Matrix Market file\n");
+        return false;
+    }
+    if (total != nz)
+    {
+        LogError("Error: Expected " << nz << " entries in the file but found "
+                                    << total << "\n");
+        return false;
+    }
+    return true;
+}
+
+} // end namespace Mongoose
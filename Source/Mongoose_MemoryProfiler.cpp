@@ -0,0 +1,409 @@
+/* ========================================================================== */
+/* === Source/Mongoose_MemoryProfiler.cpp =================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_MemoryProfiler.hpp"
+#include "Mongoose_Internal.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Mongoose
+{
+
+bool MemoryProfiler::profilingOn = false;
+
+/* One entry per TimingType, after the allocations outside of any phase */
+static const int NumPhases            = 6;
+static const char *const phaseNames[] = { "Other",      "Matching",
+                                          "Coarsening", "Refinement",
+                                          "FM",         "QP",
+                                          "IO" };
+
+/* The memory functions that were installed before profiling started */
+static void *(*baseMalloc)(size_t);
+static void *(*baseCalloc)(size_t, size_t);
+static void *(*baseRealloc)(void *, size_t);
+static void (*baseFree)(void *);
+
+struct Region
+{
+    int phase;
+    int level;
+};
+
+struct LargeAllocation
+{
+    int64_t bytes;
+    int phase;
+    int level;
+};
+
+static std::mutex profileLock;
+static std::unordered_map<void *, size_t> blockSize;
+static int64_t currentBytes = 0;
+static int64_t peakBytes    = 0;
+
+/* counts[phase + 1][level + 1], summed over all threads */
+static std::vector<MemoryCounts> counts[NumPhases + 1];
+
+/* Each edge cut runs its phases on the thread that called it, so the phases
+ * now running (innermost last) and the counts of each level since startCall
+ * (callCounts[level + 1]) are kept per thread, and cuts running at the same
+ * time on different threads do not see each other's. A thread's phases are
+ * dropped once profiling stops, and its counts once they are cleared, which
+ * is noticed the next time the thread uses them. */
+struct ThreadRegions
+{
+    uint64_t activeEpoch;
+    uint64_t countsEpoch;
+    std::vector<Region> active;
+    std::vector<MemoryCounts> callCounts;
+};
+
+static uint64_t activeEpoch = 0; /* raised when profiling stops */
+static uint64_t countsEpoch = 0; /* raised by clear()           */
+static thread_local ThreadRegions local;
+
+/* The phases running on this thread. Called with profileLock held. */
+static std::vector<Region> &activeRegions()
+{
+    if (local.activeEpoch != activeEpoch)
+    {
+        local.active.clear();
+        local.activeEpoch = activeEpoch;
+    }
+    return local.active;
+}
+
+/* The counts of this thread since startCall. Called with profileLock held. */
+static std::vector<MemoryCounts> &callCounts()
+{
+    if (local.countsEpoch != countsEpoch)
+    {
+        local.callCounts.clear();
+        local.countsEpoch = countsEpoch;
+    }
+    return local.callCounts;
+}
+
+/* The largest allocations, largest first */
+static std::vector<LargeAllocation> largest;
+
+/* The counts of a level, added if need be. Throws if out of memory. */
+static MemoryCounts &levelEntry(std::vector<MemoryCounts> &entries, int level)
+{
+    size_t index = static_cast<size_t>(level + 1);
+    if (entries.size() <= index)
+    {
+        MemoryCounts unused;
+        memset(&unused, 0, sizeof(unused));
+        entries.resize(index + 1, unused);
+    }
+    return entries[index];
+}
+
+/* Raise the peaks of the phases running on this thread (or of no phase) to
+ * the bytes now in use. Called with profileLock held. */
+static void updatePeaks()
+{
+    std::vector<Region> &active = activeRegions();
+    peakBytes                   = std::max(peakBytes, currentBytes);
+    if (active.empty())
+    {
+        MemoryCounts &other = levelEntry(counts[0], -1);
+        other.peakBytes     = std::max(other.peakBytes, currentBytes);
+    }
+    for (size_t r = 0; r < active.size(); r++)
+    {
+        MemoryCounts &phase
+            = levelEntry(counts[active[r].phase + 1], active[r].level);
+        MemoryCounts &call = levelEntry(callCounts(), active[r].level);
+        phase.peakBytes    = std::max(phase.peakBytes, currentBytes);
+        call.peakBytes     = std::max(call.peakBytes, currentBytes);
+    }
+}
+
+static void recordAllocation(void *p, size_t size)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    try
+    {
+        blockSize[p] = size;
+        currentBytes += static_cast<int64_t>(size);
+
+        std::vector<Region> &active = activeRegions();
+        Region top = (active.empty()) ? Region{ -1, -1 } : active.back();
+        MemoryCounts &phase = levelEntry(counts[top.phase + 1], top.level);
+        MemoryCounts &call  = levelEntry(callCounts(), top.level);
+        phase.allocations++;
+        phase.bytes += static_cast<int64_t>(size);
+        call.allocations++;
+        call.bytes += static_cast<int64_t>(size);
+        updatePeaks();
+
+        LargeAllocation allocation = { static_cast<int64_t>(size), top.phase,
+                                       top.level };
+        if (largest.size() < static_cast<size_t>(MemoryProfiler::NumLargest)
+            || allocation.bytes > largest.back().bytes)
+        {
+            if (largest.size()
+                == static_cast<size_t>(MemoryProfiler::NumLargest))
+                largest.pop_back();
+            size_t k = largest.size();
+            while (k > 0 && largest[k - 1].bytes < allocation.bytes)
+                k--;
+            largest.insert(largest.begin() + static_cast<long>(k), allocation);
+        }
+    }
+    catch (...)
+    {
+        // Out of memory: the block is not tracked
+    }
+}
+
+static void recordFree(void *p)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    std::unordered_map<void *, size_t>::iterator block = blockSize.find(p);
+    if (block == blockSize.end())
+        return; // Allocated before profiling started
+    currentBytes -= static_cast<int64_t>(block->second);
+    blockSize.erase(block);
+}
+
+static void *profiledMalloc(size_t size)
+{
+    void *p = baseMalloc(size);
+    if (p)
+        recordAllocation(p, size);
+    return p;
+}
+
+static void *profiledCalloc(size_t count, size_t size)
+{
+    void *p = baseCalloc(count, size);
+    if (p)
+        recordAllocation(p, count * size);
+    return p;
+}
+
+static void *profiledRealloc(void *p, size_t size)
+{
+    // Forget the old block first: once realloc returns, another thread may
+    // be given its address.
+    size_t oldSize = 0;
+    bool tracked   = false;
+    if (p)
+    {
+        std::lock_guard<std::mutex> guard(profileLock);
+        std::unordered_map<void *, size_t>::iterator block = blockSize.find(p);
+        tracked = (block != blockSize.end());
+        if (tracked)
+        {
+            oldSize = block->second;
+            currentBytes -= static_cast<int64_t>(oldSize);
+            blockSize.erase(block);
+        }
+    }
+
+    void *q = baseRealloc(p, size);
+    if (q)
+    {
+        recordAllocation(q, size);
+    }
+    else if (tracked)
+    {
+        // p is still valid and unchanged
+        std::lock_guard<std::mutex> guard(profileLock);
+        try
+        {
+            blockSize[p] = oldSize;
+            currentBytes += static_cast<int64_t>(oldSize);
+        }
+        catch (...)
+        {
+        }
+    }
+    return q;
+}
+
+static void profiledFree(void *p)
+{
+    if (p)
+        recordFree(p);
+    baseFree(p);
+}
+
+bool MemoryProfiler::setProfilingFlag(bool pFlag)
+{
+    if (pFlag == profilingOn)
+        return profilingOn;
+
+    std::lock_guard<std::mutex> guard(profileLock);
+    if (pFlag)
+    {
+        baseMalloc                      = SuiteSparse_config.malloc_func;
+        baseCalloc                      = SuiteSparse_config.calloc_func;
+        baseRealloc                     = SuiteSparse_config.realloc_func;
+        baseFree                        = SuiteSparse_config.free_func;
+        SuiteSparse_config.malloc_func  = profiledMalloc;
+        SuiteSparse_config.calloc_func  = profiledCalloc;
+        SuiteSparse_config.realloc_func = profiledRealloc;
+        SuiteSparse_config.free_func    = profiledFree;
+    }
+    else
+    {
+        // Blocks allocated while profiling are freed by the base functions
+        // from now on, so their sizes are no longer needed.
+        SuiteSparse_config.malloc_func  = baseMalloc;
+        SuiteSparse_config.calloc_func  = baseCalloc;
+        SuiteSparse_config.realloc_func = baseRealloc;
+        SuiteSparse_config.free_func    = baseFree;
+        blockSize.clear();
+        currentBytes = 0;
+        activeEpoch++;
+    }
+    profilingOn = pFlag;
+    return profilingOn;
+}
+
+void MemoryProfiler::start(int phase, int level)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    try
+    {
+        activeRegions().push_back(Region{ phase, level });
+        updatePeaks();
+    }
+    catch (...)
+    {
+        // Out of memory: allocations are charged to the enclosing phase
+    }
+}
+
+void MemoryProfiler::stop(int phase)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    std::vector<Region> &active = activeRegions();
+    for (size_t r = active.size(); r > 0; r--)
+    {
+        if (active[r - 1].phase == phase)
+        {
+            active.erase(active.begin() + static_cast<long>(r - 1));
+            return;
+        }
+    }
+}
+
+void MemoryProfiler::clear()
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    for (int phase = 0; phase <= NumPhases; phase++)
+        counts[phase].clear();
+    countsEpoch++;
+    largest.clear();
+    peakBytes = currentBytes;
+}
+
+int64_t MemoryProfiler::getCurrentBytes()
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    return currentBytes;
+}
+
+int64_t MemoryProfiler::getPeakBytes()
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    return peakBytes;
+}
+
+bool MemoryProfiler::getCounts(int phase, int level, MemoryCounts &out)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    size_t index = static_cast<size_t>(level + 1);
+    if (phase < -1 || phase >= NumPhases || level < -1
+        || index >= counts[phase + 1].size())
+        return false;
+
+    out = counts[phase + 1][index];
+    return out.allocations > 0 || out.peakBytes > 0;
+}
+
+void MemoryProfiler::startCall()
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    callCounts().clear();
+}
+
+void MemoryProfiler::getLevelCounts(int level, MemoryCounts &out)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    std::vector<MemoryCounts> &call = callCounts();
+    size_t index                    = static_cast<size_t>(level + 1);
+    if (level >= -1 && index < call.size())
+        out = call[index];
+    else
+        memset(&out, 0, sizeof(out));
+}
+
+static void printCounts(std::ostream &out, const MemoryCounts &c)
+{
+    out << ", \"Allocations\": " << static_cast<long long>(c.allocations)
+        << ", \"Bytes\": " << static_cast<long long>(c.bytes)
+        << ", \"PeakBytes\": " << static_cast<long long>(c.peakBytes) << " }";
+}
+
+void MemoryProfiler::printJSON(std::ostream &out, const std::string &indent)
+{
+    std::lock_guard<std::mutex> guard(profileLock);
+    out << "{" << std::endl;
+    out << indent << "  \"Profiling\": " << ((profilingOn) ? "true" : "false")
+        << "," << std::endl;
+    out << indent << "  \"CurrentBytes\": "
+        << static_cast<long long>(currentBytes) << "," << std::endl;
+    out << indent << "  \"PeakBytes\": " << static_cast<long long>(peakBytes);
+    for (int phase = 0; phase <= NumPhases; phase++)
+    {
+        out << "," << std::endl
+            << indent << "  \"" << phaseNames[phase] << "\": [";
+        bool first = true;
+        for (size_t index = 0; index < counts[phase].size(); index++)
+        {
+            const MemoryCounts &c = counts[phase][index];
+            if (c.allocations == 0 && c.peakBytes == 0)
+                continue;
+
+            out << ((first) ? "" : ",") << std::endl
+                << indent << "    { \"Level\": "
+                << static_cast<long>(index) - 1;
+            printCounts(out, c);
+            first = false;
+        }
+        out << ((first) ? "" : "\n" + indent + "  ") << "]";
+    }
+
+    out << "," << std::endl << indent << "  \"Largest\": [";
+    for (size_t k = 0; k < largest.size(); k++)
+    {
+        out << ((k == 0) ? "" : ",") << std::endl
+            << indent << "    { \"Bytes\": "
+            << static_cast<long long>(largest[k].bytes) << ", \"Phase\": \""
+            << phaseNames[largest[k].phase + 1]
+            << "\", \"Level\": " << largest[k].level << " }";
+    }
+    out << ((largest.empty()) ? "" : "\n" + indent + "  ") << "]";
+    out << std::endl << indent << "}";
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,125 @@
+/* ========================================================================== */
+/* === Source/Mongoose_OpCounters.cpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_OpCounters.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Mongoose
+{
+
+/* One entry per OperationType */
+static const char *const operationNames[] = {
+    "HeapInserts",     "HeapRemoves",       "HeapifySteps",
+    "NeighborUpdates", "GainCalculations",  "NapsackHeapSteps",
+    "CoarsenHashHits", "CoarsenHashMisses"
+};
+
+#ifdef MONGOOSE_OPERATION_COUNTERS
+
+/* The counts of exited threads, and the counters of running ones. */
+static std::mutex opLock;
+static int64_t retired[OpCounters::NumOperations];
+static std::vector<OpCounters::ThreadCounts *> running;
+
+thread_local OpCounters::ThreadCounts OpCounters::local;
+
+OpCounters::ThreadCounts::ThreadCounts()
+{
+    memset(count, 0, sizeof(count));
+    try
+    {
+        std::lock_guard<std::mutex> guard(opLock);
+        running.push_back(this);
+    }
+    catch (...)
+    {
+        // Out of memory: this thread's counts are added when it exits.
+    }
+}
+
+OpCounters::ThreadCounts::~ThreadCounts()
+{
+    std::lock_guard<std::mutex> guard(opLock);
+    for (int op = 0; op < NumOperations; op++)
+        retired[op] += count[op];
+    running.erase(std::remove(running.begin(), running.end(), this),
+                  running.end());
+}
+
+bool OpCounters::isEnabled()
+{
+    return true;
+}
+
+void OpCounters::getCounts(int64_t counts[NumOperations])
+{
+    std::lock_guard<std::mutex> guard(opLock);
+    for (int op = 0; op < NumOperations; op++)
+    {
+        counts[op] = retired[op];
+        for (size_t t = 0; t < running.size(); t++)
+            counts[op] += running[t]->count[op];
+    }
+}
+
+void OpCounters::clear()
+{
+    std::lock_guard<std::mutex> guard(opLock);
+    memset(retired, 0, sizeof(retired));
+    for (size_t t = 0; t < running.size(); t++)
+        memset(running[t]->count, 0, sizeof(running[t]->count));
+}
+
+#else
+
+bool OpCounters::isEnabled()
+{
+    return false;
+}
+
+void OpCounters::getCounts(int64_t counts[NumOperations])
+{
+    for (int op = 0; op < NumOperations; op++)
+        counts[op] = 0;
+}
+
+void OpCounters::clear()
+{
+}
+
+#endif
+
+const char *OpCounters::getName(OperationType op)
+{
+    return operationNames[op];
+}
+
+void OpCounters::printJSON(std::ostream &out, const std::string &indent)
+{
+    int64_t counts[NumOperations];
+    getCounts(counts);
+
+    out << "{" << std::endl;
+    out << indent << "  \"Enabled\": " << ((isEnabled()) ? "true" : "false");
+    for (int op = 0; op < NumOperations; op++)
+    {
+        out << "," << std::endl
+            << indent << "  \"" << operationNames[op]
+            << "\": " << static_cast<long long>(counts[op]);
+    }
+    out << std::endl << indent << "}";
+}
+
+} // end namespace Mongoose
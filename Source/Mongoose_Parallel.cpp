@@ -0,0 +1,263 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Parallel.cpp ========================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Work-stealing thread pool
+ *
+ * Queue k belongs to worker k, and the last queue takes the tasks spawned by
+ * threads outside of the pool. Every queue has its own lock, so threads only
+ * contend when they work on the same queue. A thread other than its owner
+ * only takes a task of a group while the group has fewer helpers than it
+ * allows. Idle workers sleep until a task is queued or a helper leaves a
+ * group; a thread waiting for a group also wakes when the group finishes.
+ */
+
+#include "Mongoose_Parallel.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace Mongoose
+{
+
+struct PoolTask
+{
+    std::function<void()> run;
+    TaskGroup *group;
+};
+
+struct TaskQueue
+{
+    std::mutex lock;
+    std::deque<PoolTask> tasks;
+};
+
+/* The queue of the calling thread, or -1 outside of the pool */
+static thread_local int ownQueue = -1;
+
+struct ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::deque<TaskQueue> queues;
+    std::atomic<size_t> events; /* # of tasks queued and helpers that left */
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping;
+
+    ThreadPool();
+    ~ThreadPool();
+
+    bool push(PoolTask &task);
+    bool take(PoolTask &task);
+    bool runOne();
+    void work(int self);
+};
+
+static ThreadPool &pool()
+{
+    static ThreadPool threadPool;
+    return threadPool;
+}
+
+ThreadPool::ThreadPool() : events(0), stopping(false)
+{
+    size_t numWorkers = std::thread::hardware_concurrency();
+    numWorkers        = (numWorkers > 1) ? numWorkers - 1 : 0;
+    try
+    {
+        queues.resize(numWorkers + 1);
+        for (size_t k = 0; k < numWorkers; k++)
+        {
+            workers.push_back(
+                std::thread(&ThreadPool::work, this, static_cast<int>(k)));
+        }
+    }
+    catch (...)
+    {
+        // Out of memory or threads: make do with the workers started
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t k = 0; k < workers.size(); k++)
+        workers[k].join();
+}
+
+bool ThreadPool::push(PoolTask &task)
+{
+    if (workers.empty())
+        return false;
+
+    TaskQueue &queue = queues[(ownQueue >= 0) ? static_cast<size_t>(ownQueue)
+                                              : queues.size() - 1];
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(PoolTask());
+        queue.tasks.back().run.swap(task.run);
+        queue.tasks.back().group = task.group;
+    }
+    events++;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+    }
+    // The task may be one that only some of the sleepers are allowed to take.
+    wake.notify_all();
+    return true;
+}
+
+/* Take the newest task of the caller's own queue, or else steal the oldest
+ * task of another queue, skipping the tasks of groups that have all the
+ * helpers they allow. */
+bool ThreadPool::take(PoolTask &task)
+{
+    size_t numQueues = queues.size();
+    size_t self = (ownQueue >= 0) ? static_cast<size_t>(ownQueue) : numQueues;
+    for (size_t k = 0; k < numQueues; k++)
+    {
+        size_t q         = (self + k) % numQueues;
+        TaskQueue &queue = queues[q];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        size_t count = queue.tasks.size();
+        for (size_t j = 0; j < count; j++)
+        {
+            size_t index   = (q == self) ? count - 1 - j : j;
+            PoolTask &next = queue.tasks[index];
+            if (!next.group->admit())
+                continue;
+
+            task.run.swap(next.run);
+            task.group = next.group;
+            queue.tasks.erase(queue.tasks.begin()
+                              + static_cast<std::ptrdiff_t>(index));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runOne()
+{
+    PoolTask task;
+    if (!take(task))
+        return false;
+
+    task.run();
+    task.run = nullptr; // release what the task holds before it counts done
+
+    // Leave the group before it counts done, since it may then be destroyed.
+    TaskGroup *group = task.group;
+    bool notify      = false;
+    if (std::this_thread::get_id() != group->owner)
+    {
+        group->helpers--;
+        events++;
+        notify = group->saturated.exchange(false);
+    }
+    if (--group->pending == 0)
+        notify = true;
+
+    if (notify)
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::work(int self)
+{
+    ownQueue = self;
+    for (;;)
+    {
+        size_t seen = events;
+        if (runOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [this, seen] { return stopping || events != seen; });
+        if (stopping)
+            return;
+    }
+}
+
+TaskGroup::TaskGroup()
+    : pending(0), helpers(0), maxHelpers(maxThreads() - 1), saturated(false),
+      owner(std::this_thread::get_id())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+bool TaskGroup::queue(std::function<void()> &task)
+{
+    ThreadPool &threadPool = pool();
+    PoolTask queued;
+    queued.run.swap(task);
+    queued.group = this;
+
+    pending++;
+    if (threadPool.push(queued))
+        return true;
+
+    pending--;
+    task.swap(queued.run);
+    return false;
+}
+
+void TaskGroup::wait()
+{
+    if (pending == 0)
+        return;
+
+    ThreadPool &threadPool = pool();
+    while (pending > 0)
+    {
+        size_t seen = threadPool.events;
+        if (threadPool.runOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock(threadPool.sleepLock);
+        threadPool.wake.wait(lock, [this, &threadPool, seen] {
+            return pending == 0 || threadPool.events != seen;
+        });
+    }
+}
+
+/* Whether the calling thread may run a task of the group now. A thread other
+ * than the owner is counted as a helper until the task is done. Called with
+ * the lock of the task's queue held. */
+bool TaskGroup::admit()
+{
+    if (std::this_thread::get_id() == owner)
+        return true;
+
+    size_t active = helpers;
+    while (active < maxHelpers)
+    {
+        if (helpers.compare_exchange_weak(active, active + 1))
+            return true;
+    }
+    saturated = true;
+    return false;
+}
+
+} // end namespace Mongoose
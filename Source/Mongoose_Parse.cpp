@@ -0,0 +1,116 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Parse.cpp ============================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Parse.hpp"
+#include "Mongoose_Parallel.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MONGOOSE_HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mongoose
+{
+
+bool mapFile(FILE *file, MappedFile &mapped)
+{
+    mapped.base = NULL;
+    mapped.size = 0;
+    mapped.data = mapped.end = NULL;
+
+#ifdef MONGOOSE_HAVE_MMAP
+    long start = ftell(file);
+    int fd     = fileno(file);
+    struct stat info;
+    if (start < 0 || fd < 0 || fstat(fd, &info) != 0
+        || static_cast<long>(info.st_size) < start)
+    {
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size == 0)
+        return false;
+
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(map, size, MADV_SEQUENTIAL);
+#endif
+
+    mapped.base = map;
+    mapped.size = size;
+    mapped.data = static_cast<const char *>(map) + start;
+    mapped.end  = static_cast<const char *>(map) + size;
+    return true;
+#else
+    (void)file;
+    return false;
+#endif
+}
+
+void unmapFile(MappedFile &mapped)
+{
+#ifdef MONGOOSE_HAVE_MMAP
+    if (mapped.base)
+        munmap(mapped.base, mapped.size);
+#endif
+    mapped.base = NULL;
+    mapped.size = 0;
+    mapped.data = mapped.end = NULL;
+}
+
+void splitLines(const char *data, const char *end, size_t minChunkSize,
+                std::vector<Chunk> &chunks)
+{
+    size_t length     = static_cast<size_t>(end - data);
+    size_t numThreads = maxThreads();
+    numThreads        = std::min(numThreads, length / minChunkSize + 1);
+
+    chunks.resize(numThreads);
+    const char *s = data;
+    for (size_t t = 0; t < numThreads; t++)
+    {
+        const char *e = (t + 1 == numThreads)
+                            ? end
+                            : nextLine(data + (t + 1) * (length / numThreads)
+                                           - 1,
+                                       end);
+        chunks[t].begin = s;
+        chunks[t].end   = std::max(s, e);
+        chunks[t].count = chunks[t].offset = 0;
+        chunks[t].lines = chunks[t].line = 0;
+        chunks[t].ok    = true;
+        s               = chunks[t].end;
+    }
+}
+
+Int chunkOffsets(std::vector<Chunk> &chunks)
+{
+    Int total = 0;
+    Int lines = 0;
+    for (size_t t = 0; t < chunks.size(); t++)
+    {
+        chunks[t].offset = total;
+        chunks[t].line   = lines;
+        total += chunks[t].count;
+        lines += chunks[t].lines;
+    }
+    return total;
+}
+
+} // end namespace Mongoose
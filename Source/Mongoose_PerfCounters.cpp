@@ -0,0 +1,250 @@
+/* ========================================================================== */
+/* === Source/Mongoose_PerfCounters.cpp ===================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_PerfCounters.hpp"
+#include "Mongoose_Logger.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#if defined(__linux__)
+#define MONGOOSE_HAVE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Mongoose
+{
+
+bool PerfCounters::countingOn = false;
+
+/* One entry per TimingType */
+static const int NumPhases            = IOTiming + 1;
+static const char *const phaseNames[] = { "Matching", "Coarsening",
+                                          "Refinement", "FM",
+                                          "QP",       "IO" };
+
+/* One entry per PerfCounterType */
+static const char *const counterNames[] = { "Cycles",      "Instructions",
+                                            "CacheReferences",
+                                            "CacheMisses", "Branches",
+                                            "BranchMisses" };
+static const double CacheLineBytes = 64;
+
+static int counterFd[PerfCounters::NumCounters] = { -1, -1, -1, -1, -1, -1 };
+
+struct PhaseCounts
+{
+    bool used;
+    double value[PerfCounters::NumCounters];
+};
+
+/* counts[phase][level + 1], so that phases without a level come first */
+static std::mutex countLock;
+static std::vector<PhaseCounts> counts[NumPhases];
+
+/* The regions started on each thread, so concurrent calls can each count */
+static thread_local double startValue[NumPhases][PerfCounters::NumCounters];
+static thread_local int startLevel[NumPhases];
+
+#ifdef MONGOOSE_HAVE_PERF_EVENT
+static int openCounter(uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.inherit        = 1; // include threads started while counting
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format
+        = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    return static_cast<int>(fd);
+}
+#endif
+
+/* Read a counter, scaled up if the kernel had to multiplex it. */
+static double readCounter(int fd)
+{
+#ifdef MONGOOSE_HAVE_PERF_EVENT
+    uint64_t data[3]; // value, time enabled, time running
+    if (read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+        return 0;
+    if (data[2] == 0)
+        return 0;
+    return static_cast<double>(data[0]) * (static_cast<double>(data[1])
+                                           / static_cast<double>(data[2]));
+#else
+    (void)fd;
+    return 0;
+#endif
+}
+
+bool PerfCounters::setCountingFlag(bool cFlag)
+{
+    for (int c = 0; c < NumCounters; c++)
+    {
+#ifdef MONGOOSE_HAVE_PERF_EVENT
+        if (counterFd[c] >= 0)
+            close(counterFd[c]);
+#endif
+        counterFd[c] = -1;
+    }
+    countingOn = false;
+    if (!cFlag)
+        return false;
+
+#ifdef MONGOOSE_HAVE_PERF_EVENT
+    static const uint64_t config[NumCounters]
+        = { PERF_COUNT_HW_CPU_CYCLES,       PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES };
+    for (int c = 0; c < NumCounters; c++)
+    {
+        counterFd[c] = openCounter(config[c]);
+        countingOn   = countingOn || (counterFd[c] >= 0);
+    }
+#endif
+
+    if (!countingOn)
+    {
+        LogWarn("Warning: Hardware performance counters are unavailable\n");
+    }
+    return countingOn;
+}
+
+bool PerfCounters::isAvailable(PerfCounterType counterType)
+{
+    return counterFd[counterType] >= 0;
+}
+
+void PerfCounters::start(int phase, int level)
+{
+    startLevel[phase] = level;
+    for (int c = 0; c < NumCounters; c++)
+    {
+        if (counterFd[c] >= 0)
+            startValue[phase][c] = readCounter(counterFd[c]);
+    }
+}
+
+void PerfCounters::stop(int phase)
+{
+    double value[NumCounters];
+    for (int c = 0; c < NumCounters; c++)
+    {
+        value[c] = (counterFd[c] >= 0) ? readCounter(counterFd[c]) : 0;
+    }
+
+    size_t index = static_cast<size_t>(startLevel[phase] + 1);
+    std::lock_guard<std::mutex> guard(countLock);
+    try
+    {
+        if (counts[phase].size() <= index)
+        {
+            PhaseCounts unused;
+            memset(&unused, 0, sizeof(unused));
+            counts[phase].resize(index + 1, unused);
+        }
+    }
+    catch (...)
+    {
+        return; // Out of memory: drop this region
+    }
+
+    PhaseCounts &total = counts[phase][index];
+    total.used         = true;
+    for (int c = 0; c < NumCounters; c++)
+    {
+        total.value[c] += value[c] - startValue[phase][c];
+    }
+}
+
+void PerfCounters::clear()
+{
+    std::lock_guard<std::mutex> guard(countLock);
+    for (int phase = 0; phase < NumPhases; phase++)
+    {
+        counts[phase].clear();
+    }
+}
+
+bool PerfCounters::getCounts(int phase, int level, double out[NumCounters])
+{
+    std::lock_guard<std::mutex> guard(countLock);
+    size_t index = static_cast<size_t>(level + 1);
+    if (phase < 0 || phase >= NumPhases || level < -1
+        || index >= counts[phase].size() || !counts[phase][index].used)
+        return false;
+
+    for (int c = 0; c < NumCounters; c++)
+    {
+        out[c] = counts[phase][index].value[c];
+    }
+    return true;
+}
+
+void PerfCounters::printJSON(std::ostream &out, const std::string &indent)
+{
+    std::lock_guard<std::mutex> guard(countLock);
+    out << "{" << std::endl;
+    out << indent << "  \"Available\": " << ((countingOn) ? "true" : "false");
+    for (int phase = 0; phase < NumPhases; phase++)
+    {
+        out << "," << std::endl
+            << indent << "  \"" << phaseNames[phase] << "\": [";
+        bool first = true;
+        for (size_t index = 0; index < counts[phase].size(); index++)
+        {
+            const PhaseCounts &total = counts[phase][index];
+            if (!total.used)
+                continue;
+
+            out << ((first) ? "" : ",") << std::endl
+                << indent << "    { \"Level\": "
+                << static_cast<long>(index) - 1;
+            for (int c = 0; c < NumCounters; c++)
+            {
+                out << ", \"" << counterNames[c] << "\": ";
+                if (counterFd[c] >= 0)
+                    out << static_cast<long long>(total.value[c]);
+                else
+                    out << "null";
+            }
+
+            double cycles       = total.value[CyclesCounter];
+            double instructions = total.value[InstructionsCounter];
+            out << ", \"IPC\": ";
+            if (counterFd[CyclesCounter] >= 0
+                && counterFd[InstructionsCounter] >= 0 && cycles > 0)
+                out << instructions / cycles;
+            else
+                out << "null";
+            out << ", \"MemoryBytes\": ";
+            if (counterFd[CacheMissesCounter] >= 0)
+                out << static_cast<long long>(
+                    total.value[CacheMissesCounter] * CacheLineBytes);
+            else
+                out << "null";
+            out << " }";
+            first = false;
+        }
+        out << ((first) ? "" : "\n" + indent + "  ") << "]";
+    }
+    out << std::endl << indent << "}";
+}
+
+} // end namespace Mongoose
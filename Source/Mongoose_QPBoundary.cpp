@@ -39,15 +39,19 @@
 #include "Mongoose_QPBoundary.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
+#include "Mongoose_Trace.hpp"
 
 #define EMPTY (-1)
 
 namespace Mongoose
 {
 
-void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
+template <typename Float>
+void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                QPDeltaT<Float> *QP)
 {
     (void)options; // Unused variable
+    TraceSpan span("QPBoundary", graph->clevel);
     /* ---------------------------------------------------------------------- */
     /* Step 0. read in the needed arrays                                      */
     /* ---------------------------------------------------------------------- */
@@ -70,9 +74,9 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
         return;
     }
 
-    double *x    = QP->x;        /* current estimate of solution */
-    double *grad = QP->gradient; /* gradient at current x */
-    Int ib       = QP->ib;       /* ib = +1, -1, or 0 ,
+    Float *x    = QP->x;        /* current estimate of solution */
+    Float *grad = QP->gradient; /* gradient at current x */
+    Int ib      = QP->ib;       /* ib = +1, -1, or 0 ,
          if b = hi, lo, or lo < b < hi, respectively.  Note there are cases
          where roundoff occurs, and ib can be zero even though b == lo or
          b == hi.  The value of be can even be < lo or > hi, but only by a tiny
@@ -91,7 +95,7 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
     double hi = QP->hi;
 
     /* work array */
-    double *D = QP->D; /* diagonal of quadratic */
+    Float *D = QP->D; /* diagonal of quadratic */
 
     PR(("\n----- QPBoundary start: [\n"));
     DEBUG(QPcheckCom(graph, options, QP, 1, QP->nFreeSet, QP->b)); // check b
@@ -750,4 +754,10 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
     PR(("----- QPBoundary end ]\n"));
 }
 
+/* single and double precision instances */
+template void QPBoundary<double>(EdgeCutProblem *, const EdgeCut_Options *,
+                                 QPDeltaT<double> *);
+template void QPBoundary<float>(EdgeCutProblem *, const EdgeCut_Options *,
+                                QPDeltaT<float> *);
+
 } // end namespace Mongoose
@@ -16,22 +16,22 @@
 namespace Mongoose
 {
 
-QPDelta *QPDelta::Create(Int numVars)
+template <typename Float> QPDeltaT<Float> *QPDeltaT<Float>::Create(Int numVars)
 {
-    QPDelta *ret = (QPDelta *)SuiteSparse_calloc(1, sizeof(QPDelta));
+    QPDeltaT *ret = (QPDeltaT *)SuiteSparse_calloc(1, sizeof(QPDeltaT));
     if (!ret)
         return NULL;
 
-    ret->x = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                          sizeof(double));
+    ret->x = (Float *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                         sizeof(Float));
     ret->FreeSet_status
         = (Int *)SuiteSparse_malloc(static_cast<size_t>(numVars), sizeof(Int));
     ret->FreeSet_list = (Int *)SuiteSparse_malloc(
         static_cast<size_t>(numVars + 1), sizeof(Int));
-    ret->gradient = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                                 sizeof(double));
-    ret->D        = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                          sizeof(double));
+    ret->gradient = (Float *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                                sizeof(Float));
+    ret->D        = (Float *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                         sizeof(Float));
 
     for (int i = 0; i < WISIZE; i++)
     {
@@ -41,8 +41,8 @@ QPDelta *QPDelta::Create(Int numVars)
 
     for (Int i = 0; i < WXSIZE; i++)
     {
-        ret->wx[i] = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                                  sizeof(double));
+        ret->wx[i] = (Float *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                                 sizeof(Float));
     }
 
 #ifndef NDEBUG
@@ -55,20 +55,20 @@ QPDelta *QPDelta::Create(Int numVars)
         //|| !ret->Change_location
         || !ret->wx[0] || !ret->wx[1] || !ret->wx[2])
     {
-        ret->~QPDelta();
-        ret = (QPDelta *)SuiteSparse_free(ret);
+        ret->~QPDeltaT();
+        ret = (QPDeltaT *)SuiteSparse_free(ret);
     }
 
     return ret;
 }
 
-QPDelta::~QPDelta()
+template <typename Float> QPDeltaT<Float>::~QPDeltaT()
 {
-    x              = (double *)SuiteSparse_free(x);
+    x              = (Float *)SuiteSparse_free(x);
     FreeSet_status = (Int *)SuiteSparse_free(FreeSet_status);
     FreeSet_list   = (Int *)SuiteSparse_free(FreeSet_list);
-    gradient       = (double *)SuiteSparse_free(gradient);
-    D              = (double *)SuiteSparse_free(D);
+    gradient       = (Float *)SuiteSparse_free(gradient);
+    D              = (Float *)SuiteSparse_free(D);
     // Change_location = (Int*) SuiteSparse_free(Change_location);
 
     for (Int i = 0; i < WISIZE; i++)
@@ -78,8 +78,11 @@ QPDelta::~QPDelta()
 
     for (Int i = 0; i < WXSIZE; i++)
     {
-        wx[i] = (double *)SuiteSparse_free(wx[i]);
+        wx[i] = (Float *)SuiteSparse_free(wx[i]);
     }
 }
 
+template class QPDeltaT<double>;
+template class QPDeltaT<float>;
+
 } // end namespace Mongoose
@@ -26,6 +26,7 @@
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_QPNapsack.hpp"
+#include "Mongoose_Trace.hpp"
 
 #define EMPTY (-1)
 
@@ -33,11 +34,14 @@ namespace Mongoose
 {
 
 // save the current state of the solution, just before returning from QPGradProj
-inline void saveContext(EdgeCutProblem *graph, QPDelta *QP, Int it, double err,
-                        Int nFreeSet, Int ib, double lo, double hi)
+template <typename Float>
+inline void saveContext(EdgeCutProblem *graph, QPDeltaT<Float> *QP, Int it,
+                        double err, Int nFreeSet, Int ib, double lo, double hi)
 {
     QP->its      = it;
     QP->err      = err;
+    graph->stats.qp_iterations += it;
+    graph->stats.qp_error = err;
     QP->nFreeSet = nFreeSet;
     double b     = 0.0;
     if (ib != 0)
@@ -53,8 +57,11 @@ inline void saveContext(EdgeCutProblem *graph, QPDelta *QP, Int it, double err,
     QP->b  = b;
 }
 
-double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *qpDelta)
+template <typename Float>
+double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                  QPDeltaT<Float> *qpDelta)
 {
+    TraceSpan span("QPGradProj", graph->clevel);
 
     PR(("\n------- QPGradProj start: [\n"));
     DEBUG(QPcheckCom(graph, options, qpDelta, 0, qpDelta->nFreeSet,
@@ -65,22 +72,22 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     /* ---------------------------------------------------------------------- */
 
     double tol  = options->gradproj_tolerance;
-    double *wx1 = qpDelta->wx[0]; /* work array for napsack and here as y */
-    double *wx2 = qpDelta->wx[1]; /* work array for napsack and here as Dgrad */
-    double *wx3 = qpDelta->wx[2]; /* work array used here for d=y-x */
-    Int *wi1    = qpDelta->wi[0]; /* work array for napsack
+    Float *wx1 = qpDelta->wx[0]; /* work array for napsack and here as y */
+    Float *wx2 = qpDelta->wx[1]; /* work array for napsack and here as Dgrad */
+    Float *wx3 = qpDelta->wx[2]; /* work array used here for d=y-x */
+    Int *wi1   = qpDelta->wi[0]; /* work array for napsack
                                 and here as changeList */
     Int *wi2 = qpDelta->wi[1];    /* work array only for napsack */
 
     /* Output and Input */
-    double *x = qpDelta->x; /* current estimate of solution            */
+    Float *x = qpDelta->x; /* current estimate of solution             */
     Int *FreeSet_status = qpDelta->FreeSet_status;
     /* FreeSet_status [i] = +1,-1, or 0 if x_i = 1,0, or 0 < x_i < 1 */
 
     Int nFreeSet = qpDelta->nFreeSet; /* number of i such that 0 < x_i < 1 */
     Int *FreeSet_list = qpDelta->FreeSet_list; /* list of free indices */
 
-    double *grad = qpDelta->gradient; /* gradient at current x */
+    Float *grad = qpDelta->gradient; /* gradient at current x */
 
     /* Unpack the problem's parameters. */
     Int n      = graph->n; /* problem dimension */
@@ -92,16 +99,16 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     double lo = qpDelta->lo;
     double hi = qpDelta->hi;
 
-    double *D = qpDelta->D; /* diagonal of quadratic */
+    Float *D = qpDelta->D; /* diagonal of quadratic */
 
     /* gradient projection parameters */
     Int limit = options->gradproj_iteration_limit; /* max number of iterations */
 
     /* work arrays */
-    double *y     = wx1;
-    double *wx    = wx2;
-    double *d     = wx3;
-    double *Dgrad = wx; /* gradient change       ; used in napsack as wx  */
+    Float *y     = wx1;
+    Float *wx    = wx2;
+    Float *d     = wx3;
+    Float *Dgrad = wx; /* gradient change       ; used in napsack as wx  */
 
     /* components of x change; used in napsack as wi1 */
     Int *changeList     = wi1;
@@ -172,7 +179,7 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
         /* Compute the maximum error. */
         err = -INFINITY;
         for (Int k = 0; k < n; k++)
-            err = std::max(err, fabs(y[k] - x[k]));
+            err = std::max(err, fabs((double)y[k] - x[k]));
 
         /* If we converged or got exhausted, save context and exit. */
         if ((err <= tol) || (it >= limit))
@@ -352,7 +359,7 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
             for (Int k = 0; k < nc; k++)
             {
                 Int j     = changeList[k];
-                double yj = y[j];
+                Float yj  = y[j];
                 x[j]      = yj;
 
                 Int bind; /* -1 = no change, 0 = free, +1 = bind */
@@ -503,4 +510,10 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     return err;
 }
 
+/* single and double precision instances */
+template double QPGradProj<double>(EdgeCutProblem *, const EdgeCut_Options *,
+                                   QPDeltaT<double> *);
+template double QPGradProj<float>(EdgeCutProblem *, const EdgeCut_Options *,
+                                  QPDeltaT<float> *);
+
 } // end namespace Mongoose
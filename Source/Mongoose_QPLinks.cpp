@@ -12,16 +12,20 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_QPLinks.hpp"
 #include "Mongoose_Internal.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
 
-bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
+template <typename Float>
+bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options,
+             QPDeltaT<Float> *QP)
 {
     (void)options; // Unused variable
+    TraceSpan span("QPLinks", graph->clevel);
 
     /* Inputs */
-    double *x = QP->x;
+    Float *x = QP->x;
 
     /* Unpack structures. */
     Int n      = graph->n;
@@ -31,10 +35,10 @@ bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
     double *a  = graph->w;
 
     /* working array */
-    double *D           = QP->D;
+    Float *D            = QP->D;
     Int *FreeSet_status = QP->FreeSet_status;
     Int *FreeSet_list   = QP->FreeSet_list;
-    double *grad        = QP->gradient; /* gradient at current x */
+    Float *grad         = QP->gradient; /* gradient at current x */
 
     // FreeSet is empty
     Int nFreeSet = 0;
@@ -133,4 +137,10 @@ bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
     return true;
 }
 
+/* single and double precision instances */
+template bool QPLinks<double>(EdgeCutProblem *, const EdgeCut_Options *,
+                              QPDeltaT<double> *);
+template bool QPLinks<float>(EdgeCutProblem *, const EdgeCut_Options *,
+                             QPDeltaT<float> *);
+
 } // end namespace Mongoose
@@ -25,9 +25,10 @@ namespace Mongoose
 
 /* build a max heap in heap [1..nheap] */
 
+template <typename Float>
 void QPMaxHeap_build(Int *heap, /* on input, an unsorted set of elements */
                      Int size,  /* number of elements to build into the heap */
-                     double *x)
+                     Float *x)
 {
     for (Int p = size / 2; p >= 1; p--)
         QPMaxHeapify(p, heap, size, x);
@@ -39,10 +40,11 @@ void QPMaxHeap_build(Int *heap, /* on input, an unsorted set of elements */
 
 /* delete the top element in a max heap */
 
+template <typename Float>
 Int QPMaxHeap_delete /* return new size of heap */
     (Int *heap,      /* containing indices into x, 1..n on input */
      Int size,       /* number of items in heap */
-     const double *x /* not modified */
+     const Float *x  /* not modified */
     )
 {
     if (size <= 1)
@@ -61,14 +63,15 @@ Int QPMaxHeap_delete /* return new size of heap */
 
 /* add a new leaf to a max heap */
 
+template <typename Float>
 Int QPMaxHeap_add(Int leaf,        /* the new leaf */
                   Int *heap,       /* size n, containing indices into x */
-                  const double *x, /* not modified */
+                  const Float *x,  /* not modified */
                   Int size /* number of elements in heap not counting new one */
 )
 {
     Int l, lnew, lold;
-    double xold;
+    Float xold;
 
     size++;
     lold       = size;
@@ -76,9 +79,9 @@ Int QPMaxHeap_add(Int leaf,        /* the new leaf */
     xold       = x[leaf];
     while (lold > 1)
     {
-        lnew        = lold / 2;
-        l           = heap[lnew];
-        double xnew = x[l];
+        lnew       = lold / 2;
+        l          = heap[lnew];
+        Float xnew = x[l];
 
         /* swap new and old */
         if (xnew < xold)
@@ -105,14 +108,15 @@ Int QPMaxHeap_add(Int leaf,        /* the new leaf */
 /* the heap property, except for heap [p] itself.  On output, the whole heap */
 /* satisfies the heap property. */
 
+template <typename Float>
 void QPMaxHeapify(Int p,          /* start at vertex p in the heap */
                   Int *heap,      /* size n, containing indices into x */
                   Int size,       /* heap [ ... nheap] is in use */
-                  const double *x /* not modified */
+                  const Float *x  /* not modified */
 )
 {
     Int left, right, e, hleft, hright;
-    double xe, xleft, xright;
+    Float xe, xleft, xright;
 
     e  = heap[p];
     xe = x[e];
@@ -174,4 +178,14 @@ void QPMaxHeapify(Int p,          /* start at vertex p in the heap */
     }
 }
 
+/* single and double precision instances */
+template void QPMaxHeap_build<double>(Int *, Int, double *);
+template Int QPMaxHeap_delete<double>(Int *, Int, const double *);
+template void QPMaxHeapify<double>(Int, Int *, Int, const double *);
+template Int QPMaxHeap_add<double>(Int, Int *, const double *, Int);
+template void QPMaxHeap_build<float>(Int *, Int, float *);
+template Int QPMaxHeap_delete<float>(Int *, Int, const float *);
+template void QPMaxHeapify<float>(Int, Int *, Int, const float *);
+template Int QPMaxHeap_add<float>(Int, Int *, const float *, Int);
+
 } // end namespace Mongoose
@@ -25,9 +25,10 @@ namespace Mongoose
 
 /* build a min heap in heap [1..nheap] */
 
+template <typename Float>
 void QPMinHeap_build(Int *heap, /* on input, an unsorted set of elements */
                      Int size,  /* number of elements to build into the heap */
-                     double *x)
+                     Float *x)
 {
     Int p;
 
@@ -43,10 +44,11 @@ void QPMinHeap_build(Int *heap, /* on input, an unsorted set of elements */
 
 /* delete the top element in a min heap */
 
+template <typename Float>
 Int QPMinHeap_delete /* return new size of heap */
     (Int *heap,      /* containing indices into x, 1..n on input */
      Int size,       /* number of items in heap */
-     const double *x /* not modified */
+     const Float *x  /* not modified */
     )
 {
     if (size <= 1)
@@ -67,15 +69,16 @@ Int QPMinHeap_delete /* return new size of heap */
 
 /* add a new leaf to a min heap */
 
+template <typename Float>
 Int QPMinHeap_add(
     Int leaf,        /* the new leaf */
     Int *heap,       /* size n, containing indices into x */
-    const double *x, /* not modified */
+    const Float *x,  /* not modified */
     Int nheap        /* number of elements in heap not counting new one */
 )
 {
     Int l, lnew, lold;
-    double xold;
+    Float xold;
 
     nheap++;
     lold       = nheap;
@@ -83,9 +86,9 @@ Int QPMinHeap_add(
     xold       = x[leaf];
     while (lold > 1)
     {
-        lnew        = lold / 2;
-        l           = heap[lnew];
-        double xnew = x[l];
+        lnew       = lold / 2;
+        l          = heap[lnew];
+        Float xnew = x[l];
 
         /* swap new and old */
         if (xnew > xold)
@@ -111,14 +114,15 @@ Int QPMinHeap_add(
 /* the heap property, except for heap [p] itself.  On output, the whole heap  */
 /* satisfies the heap property. */
 
+template <typename Float>
 void QPMinHeapify(Int p,          /* start at vertex p in the heap */
                   Int *heap,      /* size n, containing indices into x */
                   Int size,       /* heap [ ... nheap] is in use */
-                  const double *x /* not modified */
+                  const Float *x  /* not modified */
 )
 {
     Int left, right, e, hleft, hright;
-    double xe, xleft, xright;
+    Float xe, xleft, xright;
 
     e  = heap[p];
     xe = x[e];
@@ -179,4 +183,14 @@ void QPMinHeapify(Int p,          /* start at vertex p in the heap */
     }
 }
 
+/* single and double precision instances */
+template void QPMinHeap_build<double>(Int *, Int, double *);
+template Int QPMinHeap_delete<double>(Int *, Int, const double *);
+template void QPMinHeapify<double>(Int, Int *, Int, const double *);
+template Int QPMinHeap_add<double>(Int, Int *, const double *, Int);
+template void QPMinHeap_build<float>(Int *, Int, float *);
+template Int QPMinHeap_delete<float>(Int *, Int, const float *);
+template void QPMinHeapify<float>(Int, Int *, Int, const float *);
+template Int QPMinHeap_add<float>(Int, Int *, const float *, Int);
+
 } // end namespace Mongoose
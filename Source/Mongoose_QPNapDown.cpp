@@ -27,18 +27,20 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_OpCounters.hpp"
 #include "Mongoose_QPMaxHeap.hpp"
 
 namespace Mongoose
 {
 
+template <typename Float>
 double QPNapDown       /* return lambda */
-    (const double *x,  /* holds y on input, not modified */
+    (const Float *x,   /* holds y on input, not modified */
      const Int n,      /* size of x */
      double lambda,    /* initial guess for the shift */
      const double *a,  /* input constraint vector */
      double b,         /* input constraint scalar */
-     double *breakpts, /* break points */
+     Float *breakpts,  /* break points */
      Int *bound_heap,  /* work array */
      Int *free_heap    /* work array */
     )
@@ -124,6 +126,7 @@ double QPNapDown       /* return lambda */
                 ai = (a) ? a[e] : 1;
                 a2sum -= ai * ai;
                 asum += ai * (1. - x[e]);
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_free = QPMaxHeap_delete(free_heap, n_free, breakpts);
                 if (n_free == 0)
                 {
@@ -137,12 +140,14 @@ double QPNapDown       /* return lambda */
         {
             while (breakpts[e = bound_heap[1]] >= lambda)
             {
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_bound = QPMaxHeap_delete(bound_heap, n_bound, breakpts);
                 ai      = (a) ? a[e] : 1;
                 a2sum += ai * ai;
                 asum += ai * x[e];
                 t           = (x[e] - 1.) / ai;
                 breakpts[e] = t;
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_free      = QPMaxHeap_add(e, free_heap, breakpts, n_free);
                 if (n_bound == 0)
                     break;
@@ -163,4 +168,10 @@ double QPNapDown       /* return lambda */
     return lambda;
 }
 
+/* single and double precision instances */
+template double QPNapDown<double>(const double *, Int, double, const double *,
+                                  double, double *, Int *, Int *);
+template double QPNapDown<float>(const float *, Int, double, const double *,
+                                 double, float *, Int *, Int *);
+
 } // end namespace Mongoose
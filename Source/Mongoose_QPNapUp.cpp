@@ -26,18 +26,20 @@
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_OpCounters.hpp"
 #include "Mongoose_QPMinHeap.hpp"
 
 namespace Mongoose
 {
 
+template <typename Float>
 double QPNapUp         /* return lambda */
-    (const double *x,  /* holds y on input, not modified */
+    (const Float *x,   /* holds y on input, not modified */
      const Int n,      /* size of x */
      double lambda,    /* initial guess for the shift */
      const double *a,  /* input constraint vector */
      double b,         /* input constraint scalar */
-     double *breakpts, /* break points */
+     Float *breakpts,  /* break points */
      Int *bound_heap,  /* work array */
      Int *free_heap    /* work array */
     )
@@ -118,6 +120,7 @@ double QPNapUp         /* return lambda */
                 ai = (a) ? a[e] : 1;
                 a2sum -= ai * ai;
                 asum -= ai * x[e];
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_free = QPMinHeap_delete(free_heap, n_free, breakpts);
                 if (n_free == 0)
                 {
@@ -131,12 +134,14 @@ double QPNapUp         /* return lambda */
         {
             while (breakpts[e = bound_heap[1]] <= lambda)
             {
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_bound = QPMinHeap_delete(bound_heap, n_bound, breakpts);
                 ai      = (a) ? a[e] : 1;
                 a2sum += ai * ai;
                 asum += ai * (x[e] - 1.);
                 t           = x[e] / ai;
                 breakpts[e] = t;
+                MONGOOSE_COUNT(NapsackHeapStepOp);
                 n_free      = QPMinHeap_add(e, free_heap, breakpts, n_free);
                 if (n_bound == 0)
                     break;
@@ -157,4 +162,10 @@ double QPNapUp         /* return lambda */
     return lambda;
 }
 
+/* single and double precision instances */
+template double QPNapUp<double>(const double *, Int, double, const double *,
+                                double, double *, Int *, Int *);
+template double QPNapUp<float>(const float *, Int, double, const double *,
+                               double, float *, Int *, Int *);
+
 } // end namespace Mongoose
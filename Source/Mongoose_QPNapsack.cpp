@@ -97,6 +97,7 @@
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_QPNapDown.hpp"
 #include "Mongoose_QPNapUp.hpp"
+#include "Mongoose_Trace.hpp"
 
 #include <cfloat>
 
@@ -104,7 +105,8 @@ namespace Mongoose
 {
 
 #ifndef NDEBUG
-void checkatx(double *x, double *a, Int n, double lo, double hi, double tol)
+template <typename Float>
+void checkatx(Float *x, double *a, Int n, double lo, double hi, double tol)
 {
     double atx = 0.;
     int ok     = 1;
@@ -150,8 +152,9 @@ void checkatx(double *x, double *a, Int n, double lo, double hi, double tol)
 }
 #endif
 
+template <typename Float>
 double QPNapsack    /* return the final lambda */
-    (double *x,     /* holds y on input, and the solution x on output */
+    (Float *x,      /* holds y on input, and the solution x on output */
      Int n,         /* size of x, constraint lo <= a'x <= hi */
      double lo,     /* partition lower bound */
      double hi,     /* partition upper bound */
@@ -160,13 +163,14 @@ double QPNapsack    /* return the final lambda */
      const Int *FreeSet_status,
      /* FreeSet_status [i] = +1,-1, or 0 on input,
         for 3 cases: x_i =1,0, or 0< x_i< 1.  Not modified. */
-     double *w,  /* work array of size n   */
+     Float *w,   /* work array of size n   */
      Int *heap1, /* work array of size n+1 */
      Int *heap2, /* work array of size n+1 */
      double tol  /* Gradient projection tolerance */
     )
 {
     (void)tol; // unused variable except during debug
+    TraceSpan span("QPNapsack");
     double lambda = Lambda;
     PR(("QPNapsack start [\n"));
 
@@ -405,4 +409,11 @@ double QPNapsack    /* return the final lambda */
     return lambda;
 }
 
+/* single and double precision instances */
+template double QPNapsack<double>(double *, Int, double, double, double *,
+                                  double, const Int *, double *, Int *, Int *,
+                                  double);
+template double QPNapsack<float>(float *, Int, double, double, double *, double,
+                                 const Int *, float *, Int *, Int *, double);
+
 } // end namespace Mongoose
@@ -11,39 +11,22 @@
 
 #include "Mongoose_Random.hpp"
 
-#if CPP11_OR_LATER
-#include <random>
-#endif
-
 namespace Mongoose
 {
 
-#if CPP11_OR_LATER
-std::random_device rd;
-std::ranlux24_base generator(rd());
-std::uniform_int_distribution<> distribution;
-#endif
+/* The key and the next counter of each thread's sequence */
+static thread_local uint64_t sequenceKey = randomKey(0, -1);
+static thread_local uint64_t sequenceCount = 0;
 
 Int random()
 {
-#if CPP11_OR_LATER
-    // Use C++11 random object
-    return distribution(generator);
-#else
-    // Forced to use non-reentrant std::rand
-    return std::rand();
-#endif
+    return static_cast<Int>(randomBits(sequenceKey, sequenceCount++) >> 33);
 }
 
 void setRandomSeed(Int seed)
 {
-#if CPP11_OR_LATER
-    // Use C++11 random object
-    generator.seed(static_cast<unsigned int>(seed));
-#else
-    // Forced to use non-reentrant std::rand
-    std::srand(static_cast<unsigned int>(seed));
-#endif
+    sequenceKey   = randomKey(seed, -1);
+    sequenceCount = 0;
 }
 
 } // end namespace Mongoose
@@ -14,13 +14,16 @@
 #include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_Trace.hpp"
 
 namespace Mongoose
 {
 
 EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
-    Logger::tic(RefinementTiming);
+    // Recorded at the level being refined onto
+    TraceSpan span("Refinement", graph->clevel - 1);
+    Logger::tic(RefinementTiming, graph->clevel - 1);
 
     EdgeCutProblem *P             = graph->parent;
     Int cn               = graph->n;
@@ -35,6 +38,25 @@ EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
     P->W1        = graph->W1;
     P->imbalance = graph->imbalance;
 
+    /* Transfer the waterdance payoffs upwards. */
+    P->fmPayoff  = graph->fmPayoff;
+    P->qpPayoff  = graph->qpPayoff;
+    P->qpProbe   = graph->qpProbe;
+    P->danceTime = graph->danceTime;
+
+    /* Prolong the continuous QP solution, if any, to warm start the QP on
+     * the fine level.  If there is no memory for it, the fine level QP
+     * simply starts from the discrete partition. */
+    double *cQP = graph->qpSolution;
+    double *fQP = NULL;
+    if (cQP)
+    {
+        P->qpSolution = (double *)SuiteSparse_free(P->qpSolution);
+        fQP = (double *)SuiteSparse_malloc(static_cast<size_t>(P->n),
+                                           sizeof(double));
+        P->qpSolution = fQP;
+    }
+
     /* For each vertex in the coarse graph. */
     for (Int k = 0; k < cn; k++)
     {
@@ -60,6 +82,8 @@ EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
         {
             Int vertex           = v[i];
             P->partition[vertex] = cp;
+            if (fQP)
+                fQP[vertex] = cQP[k];
         }
     }
     /* See if we can relax the boundary constraint and recompute gains for
@@ -80,6 +80,163 @@ cs *sanitizeMatrix(cs *compressed_A, bool symmetricTriangular,
     return cleanMatrix;
 }
 
+cs *sanitizeTriplets(cs *T, bool symmetricTriangular,
+                     bool makeEdgeWeightsBinary)
+{
+    if (!T)
+        return NULL;
+
+    Int n      = T->n;
+    Int nz     = T->nz;
+    Int *Ti    = T->i;
+    Int *Tj    = T->p;
+    double *Tx = T->x;
+    bool values = (Tx != NULL);
+
+    // A triangular matrix is mirrored as is, otherwise A is symmetrized as
+    // 0.5*(A + A'). Either way each off-diagonal entry appears twice.
+    double scale = (symmetricTriangular) ? 1 : 0.5;
+
+    Int *Rp = (Int *)SuiteSparse_calloc(static_cast<size_t>(n + 1),
+                                        sizeof(Int));
+    Int *w = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    if (!Rp || !w)
+    {
+        SuiteSparse_free(Rp);
+        SuiteSparse_free(w);
+        cs_spfree(T);
+        return NULL;
+    }
+
+    // The pattern of the result is symmetric, so its row counts are also its
+    // column counts.
+    for (Int k = 0; k < nz; k++)
+    {
+        if (Ti[k] != Tj[k])
+        {
+            Rp[Ti[k] + 1]++;
+            Rp[Tj[k] + 1]++;
+        }
+    }
+    for (Int r = 0; r < n; r++)
+    {
+        Rp[r + 1] += Rp[r];
+        w[r] = Rp[r];
+    }
+
+    Int Rnz    = Rp[n];
+    Int *Rj    = (Int *)SuiteSparse_malloc(static_cast<size_t>(Rnz),
+                                           sizeof(Int));
+    double *Rx = (values) ? (double *)SuiteSparse_malloc(
+                     static_cast<size_t>(Rnz), sizeof(double))
+                          : NULL;
+    if (!Rj || (values && !Rx))
+    {
+        SuiteSparse_free(Rp);
+        SuiteSparse_free(w);
+        SuiteSparse_free(Rj);
+        SuiteSparse_free(Rx);
+        cs_spfree(T);
+        return NULL;
+    }
+
+    // Pass 1: bucket the entries by row. All of A comes before all of A' so
+    // that duplicates are summed in the same order as cs_add(A, A').
+    for (Int k = 0; k < nz; k++)
+    {
+        if (Ti[k] != Tj[k])
+        {
+            Int q = w[Ti[k]]++;
+            Rj[q] = Tj[k];
+            if (values)
+                Rx[q] = scale * Tx[k];
+        }
+    }
+    for (Int k = 0; k < nz; k++)
+    {
+        if (Ti[k] != Tj[k])
+        {
+            Int q = w[Tj[k]]++;
+            Rj[q] = Ti[k];
+            if (values)
+                Rx[q] = scale * Tx[k];
+        }
+    }
+    cs_spfree(T);
+
+    // Sum duplicates, compacting each row in place.
+    for (Int r = 0; r < n; r++)
+        w[r] = -1;
+    Int nnz    = 0;
+    Int old_Rp = Rp[0];
+    for (Int r = 0; r < n; r++)
+    {
+        Int start = nnz;
+        for (Int p = old_Rp; p < Rp[r + 1]; p++)
+        {
+            Int c = Rj[p];
+            if (w[c] >= start)
+            {
+                if (values)
+                    Rx[w[c]] += Rx[p];
+            }
+            else
+            {
+                w[c]    = nnz;
+                Rj[nnz] = c;
+                if (values)
+                    Rx[nnz] = Rx[p];
+                nnz++;
+            }
+        }
+        old_Rp = Rp[r + 1];
+        Rp[r]  = start;
+    }
+    Rp[n] = nnz;
+
+    SuiteSparse_free(w);
+
+    // Pass 2: bucket the rows by column. Rows are visited in order, so the
+    // row indices within each column come out sorted. The pattern is
+    // symmetric, so this is just the transpose of the row-bucketed matrix.
+    cs R;
+    R.nzmax = nnz;
+    R.m     = n;
+    R.n     = n;
+    R.p     = Rp;
+    R.i     = Rj;
+    R.x     = Rx;
+    R.nz    = -1;
+    cs *C   = cs_transpose(&R, values);
+    SuiteSparse_free(Rp);
+    SuiteSparse_free(Rj);
+    SuiteSparse_free(Rx);
+    if (!C)
+        return NULL;
+
+    if (C->x)
+    {
+        for (Int p = 0; p < nnz; p++)
+        {
+            if (makeEdgeWeightsBinary)
+            {
+                // Make edge weights binary
+                if (C->x[p] != 0)
+                {
+                    C->x[p] = 1;
+                }
+            }
+            else
+            {
+                // Force edge weights to be positive
+                C->x[p] = fabs(C->x[p]);
+            }
+        }
+    }
+
+    return C;
+}
+
 void removeDiagonal(cs *A)
 {
     Int n      = A->n;
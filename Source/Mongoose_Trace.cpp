@@ -0,0 +1,157 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Trace.cpp ============================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Trace.hpp"
+#include "Mongoose_Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace Mongoose
+{
+
+bool Trace::tracingOn = false;
+
+struct TraceEvent
+{
+    const char *name;
+    Int level;
+    int64_t start;
+    int64_t end;
+    int thread;
+};
+
+/* Spans are recorded once per phase rather than in inner loops, so a single
+ * locked list is cheap enough even when several threads are tracing. */
+static std::mutex traceLock;
+static std::vector<TraceEvent> traceEvents;
+
+/* Chrome traces identify threads by small integers, handed out in the order
+ * in which threads first record a span. */
+static std::atomic<int> nextThread(0);
+
+static int threadNumber()
+{
+    static thread_local int number = nextThread++;
+    return number;
+}
+
+void Trace::setTracingFlag(bool tFlag)
+{
+    tracingOn = tFlag;
+}
+
+void Trace::clear()
+{
+    std::lock_guard<std::mutex> guard(traceLock);
+    traceEvents.clear();
+}
+
+Int Trace::getNumSpans()
+{
+    std::lock_guard<std::mutex> guard(traceLock);
+    return static_cast<Int>(traceEvents.size());
+}
+
+int64_t Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void Trace::record(const char *name, Int level, int64_t start, int64_t end)
+{
+    TraceEvent event = { name, level, start, end, threadNumber() };
+    try
+    {
+        std::lock_guard<std::mutex> guard(traceLock);
+        traceEvents.push_back(event);
+    }
+    catch (...)
+    {
+        // Out of memory: drop the span rather than fail the partitioning.
+    }
+}
+
+/* Earlier spans first, and of two spans starting together the longer (the
+ * enclosing) one first, so that viewers nest them correctly. */
+static bool spanOrder(const TraceEvent &a, const TraceEvent &b)
+{
+    if (a.start != b.start)
+        return a.start < b.start;
+    return a.end > b.end;
+}
+
+bool Trace::writeChromeTrace(const std::string &filename)
+{
+    return writeChromeTrace(filename.c_str());
+}
+
+bool Trace::writeChromeTrace(const char *filename)
+{
+    FILE *file = fopen(filename, "w");
+    if (!file)
+    {
+        LogError("Error: Cannot write file " << std::string(filename) << "\n");
+        return false;
+    }
+
+    std::vector<TraceEvent> events;
+    try
+    {
+        std::lock_guard<std::mutex> guard(traceLock);
+        events = traceEvents;
+    }
+    catch (...)
+    {
+        LogError("Error: Ran out of memory in Mongoose::Trace\n");
+        fclose(file);
+        return false;
+    }
+    std::sort(events.begin(), events.end(), spanOrder);
+
+    // Timestamps are in microseconds from the first span.
+    int64_t origin = (events.empty()) ? 0 : events[0].start;
+    bool ok        = (fputs("{\"traceEvents\":[\n", file) >= 0);
+    for (size_t k = 0; ok && k < events.size(); k++)
+    {
+        const TraceEvent &event = events[k];
+        ok = fprintf(file,
+                     "{\"name\":\"%s\",\"cat\":\"mongoose\",\"ph\":\"X\","
+                     "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+                     event.name, (event.start - origin) / 1e3,
+                     (event.end - event.start) / 1e3, event.thread)
+             >= 0;
+        if (ok && event.level >= 0)
+        {
+            ok = fprintf(file, ",\"args\":{\"level\":%ld}",
+                         static_cast<long>(event.level))
+                 >= 0;
+        }
+        ok = ok && fputs((k + 1 < events.size()) ? "},\n" : "}\n", file) >= 0;
+    }
+    ok = ok && fputs("],\"displayTimeUnit\":\"ms\"}\n", file) >= 0;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        LogError("Error: Could not write trace file\n");
+    }
+
+    return ok;
+}
+
+} // end namespace Mongoose
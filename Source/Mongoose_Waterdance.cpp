@@ -13,12 +13,86 @@
 #include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_ImproveQP.hpp"
 #include "Mongoose_Internal.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <algorithm>
 
 namespace Mongoose
 {
 
-void waterdance(EdgeCutProblem *graph, const EdgeCut_Options *options)
+/* Relative improvement in heuCost per second of wall-clock time. */
+static double payoff(double before, double after, int64_t start)
+{
+    if (before <= 0)
+        return 0;
+
+    double seconds = (Trace::now() - start) / 1e9;
+    return ((before - after) / before) / std::max(seconds, 1e-6);
+}
+
+/* Measure the payoff of FM and QP and spend effort on the refiners that
+ * still improve the cut.  FM is cheap and local, so it always makes the first
+ * dance of a level.  QP is skipped on a level if its payoff fell below the
+ * minimum on the previous level, but never on two levels in a row, so that
+ * its payoff is measured again.  Within a level, a refiner drops out once its
+ * payoff is negligible, and dances are repeated up to waterdance_max_dances
+ * times while a refiner keeps paying off.  The waterdance stops once the total
+ * time budget (if any) is spent. */
+static void adaptiveWaterdance(EdgeCutProblem *graph,
+                               const EdgeCut_Options *options)
+{
+    double minPayoff = options->waterdance_min_payoff;
+    double budget    = options->waterdance_time_budget;
+    Int numDances    = options->num_dances;
+    Int maxDances    = std::max(numDances, options->waterdance_max_dances);
+
+    if (numDances == 0)
+        return;
+
+    bool runFM = options->use_FM;
+    bool runQP = options->use_QP_gradproj
+                 && (graph->qpProbe || graph->qpPayoff >= minPayoff);
+    graph->qpProbe = !runQP;
+
+    int64_t danceStart = Trace::now();
+    for (Int i = 0; i < maxDances && (runFM || runQP); i++)
+    {
+        if (budget > 0
+            && graph->danceTime + (Trace::now() - danceStart) / 1e9 >= budget)
+        {
+            break;
+        }
+
+        if (runFM)
+        {
+            double before = graph->heuCost;
+            int64_t start = Trace::now();
+            improveCutUsingFM(graph, options);
+            graph->fmPayoff = payoff(before, graph->heuCost, start);
+            runFM           = (graph->fmPayoff >= minPayoff);
+        }
+
+        if (runQP)
+        {
+            double before = graph->heuCost;
+            int64_t start = Trace::now();
+            improveCutUsingQP(graph, options);
+            graph->qpPayoff = payoff(before, graph->heuCost, start);
+            runQP           = (graph->qpPayoff >= minPayoff);
+        }
+    }
+
+    graph->danceTime += (Trace::now() - danceStart) / 1e9;
+}
+
+static void danceWith(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
+    if (options->use_adaptive_waterdance)
+    {
+        adaptiveWaterdance(graph, options);
+        return;
+    }
+
     Int numDances = options->num_dances;
     for (Int i = 0; i < numDances; i++)
     {
@@ -27,4 +101,27 @@ void waterdance(EdgeCutProblem *graph, const EdgeCut_Options *options)
     }
 }
 
+void waterdance(EdgeCutProblem *graph, const EdgeCut_Options *options)
+{
+    TraceSpan span("Waterdance", graph->clevel);
+
+    if (!options->collect_stats)
+    {
+        danceWith(graph, options);
+        return;
+    }
+
+    /* The cut cost is counted twice until cleanup. */
+    EdgeCut_LevelStats &stats = graph->stats;
+    stats.cut_cost_before     = graph->cutCost / 2;
+    stats.imbalance_before    = fabs(graph->imbalance);
+    int64_t start             = Trace::now();
+
+    danceWith(graph, options);
+
+    stats.waterdance_time += (Trace::now() - start) / 1e9;
+    stats.cut_cost_after  = graph->cutCost / 2;
+    stats.imbalance_after = fabs(graph->imbalance);
+}
+
 } // end namespace Mongoose
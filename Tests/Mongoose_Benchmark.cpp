@@ -0,0 +1,475 @@
+/* ========================================================================== */
+/* === Tests/Mongoose_Benchmark.cpp ========================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Microbenchmarks of the individual kernels
+ *
+ * Each kernel runs on a problem that is rebuilt, outside of the timed region,
+ * before every run, so that every run does the same work: the random number
+ * generator is reseeded, the problem is reinitialized, and the kernels that
+ * the measured one depends on are run first. After a number of warmup runs,
+ * the wall-clock time of each run is recorded, and the minimum, median, 90th
+ * percentile, maximum and mean are written as JSON.
+ *
+ *     mongoose_benchmark [--warmup=2] [--repetitions=10] [--kernel=name]
+ *                        [--output=file.json] [graph ...]
+ *
+ * A graph is a Matrix Market file or a generate_graph specification such as
+ * grid2d:k, a k-by-k five point grid. With no graphs, a few of the bundled
+ * matrices and a 512-by-512 grid are used.
+ */
+
+#include "Mongoose_BoundaryHeap.hpp"
+#include "Mongoose_Coarsening.hpp"
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_Generators.hpp"
+#include "Mongoose_IO.hpp"
+#include "Mongoose_ImproveFM.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Matching.hpp"
+#include "Mongoose_QPDelta.hpp"
+#include "Mongoose_QPGradProj.hpp"
+#include "Mongoose_QPLinks.hpp"
+#include "Mongoose_QPNapsack.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_Refinement.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Mongoose;
+
+static const Int BenchmarkSeed = 12345;
+
+struct BenchState
+{
+    std::string source;      /* file name, or empty for a generated graph */
+    Graph *graph;
+    EdgeCut_Options *options;
+    EdgeCutProblem *problem; /* the input graph as a problem   */
+    EdgeCutProblem *coarse;  /* next coarser level, if any     */
+    QPDelta *QP;
+    double *y;               /* napsack input                  */
+    cs *matrix;              /* result of read_matrix          */
+};
+
+struct Kernel
+{
+    const char *name;
+    bool needsFile;
+    void (*setup)(BenchState &);
+    void (*run)(BenchState &);
+    void (*teardown)(BenchState &);
+};
+
+/* -------------------------------------------------------------------------- */
+/* Setup helpers                                                              */
+/* -------------------------------------------------------------------------- */
+
+static void reset(BenchState &s)
+{
+    setRandomSeed(BenchmarkSeed);
+    s.problem->initialize(s.options);
+}
+
+/* A random partition with its boundary heaps loaded */
+static void loadRandomCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
+{
+    for (Int k = 0; k < graph->n; k++)
+        graph->partition[k] = (Mongoose::random() % 2 == 0);
+    bhLoad(graph, options);
+}
+
+/* The QP starting guess, as in improveCutUsingQP */
+static void loadQPGuess(BenchState &s)
+{
+    EdgeCutProblem *graph = s.problem;
+    QPDelta *QP           = s.QP;
+    double targetSplit    = s.options->target_split;
+    double tol            = s.options->soft_split_tolerance;
+
+    QP->lo = graph->W * std::max(0., targetSplit - tol);
+    QP->hi = graph->W * std::min(1., targetSplit + tol);
+    for (Int k = 0; k < graph->n; k++)
+    {
+        bool inBoundary = graph->BH_inBoundary(k);
+        QP->x[k]        = (graph->partition[k]) ? (inBoundary ? 0.75 : 1.0)
+                                                : (inBoundary ? 0.25 : 0.0);
+        double maxWeight = 0;
+        for (Int p = graph->p[k]; p < graph->p[k + 1]; p++)
+            maxWeight = std::max(maxWeight, (graph->x) ? graph->x[p] : 1);
+        QP->D[k] = maxWeight;
+    }
+    QP->lambda = 0;
+}
+
+static void setupMatching(BenchState &s)
+{
+    reset(s);
+}
+
+static void setupAfterHEM(BenchState &s)
+{
+    reset(s);
+    matching_HEM(s.problem, s.options);
+}
+
+static void setupCoarsen(BenchState &s)
+{
+    reset(s);
+    match(s.problem, s.options);
+}
+
+static void setupRefine(BenchState &s)
+{
+    reset(s);
+    match(s.problem, s.options);
+    s.coarse = coarsen(s.problem, s.options);
+    if (s.coarse)
+        loadRandomCut(s.coarse, s.options);
+}
+
+static void setupPartition(BenchState &s)
+{
+    reset(s);
+    for (Int k = 0; k < s.problem->n; k++)
+        s.problem->partition[k] = (Mongoose::random() % 2 == 0);
+}
+
+static void setupCut(BenchState &s)
+{
+    reset(s);
+    loadRandomCut(s.problem, s.options);
+}
+
+static void setupQPLinks(BenchState &s)
+{
+    setupCut(s);
+    loadQPGuess(s);
+}
+
+static void setupQPGradProj(BenchState &s)
+{
+    setupQPLinks(s);
+    QPLinks(s.problem, s.options, s.QP);
+}
+
+static void setupQPNapsack(BenchState &s)
+{
+    setupQPGradProj(s);
+    for (Int k = 0; k < s.problem->n; k++)
+        s.QP->x[k] = s.y[k];
+}
+
+/* -------------------------------------------------------------------------- */
+/* Kernels                                                                    */
+/* -------------------------------------------------------------------------- */
+
+static void runHEM(BenchState &s)
+{
+    matching_HEM(s.problem, s.options);
+}
+
+static void runSR(BenchState &s)
+{
+    matching_SR(s.problem, s.options);
+}
+
+static void runSRdeg(BenchState &s)
+{
+    matching_SRdeg(s.problem, s.options);
+}
+
+static void runCoarsen(BenchState &s)
+{
+    s.coarse = coarsen(s.problem, s.options);
+}
+
+static void freeCoarse(BenchState &s)
+{
+    if (s.coarse)
+        s.coarse->~EdgeCutProblem();
+    s.coarse = NULL;
+}
+
+static void runRefine(BenchState &s)
+{
+    if (s.coarse)
+        refine(s.coarse, s.options); // frees the coarse level
+    s.coarse = NULL;
+}
+
+static void runBhLoad(BenchState &s)
+{
+    bhLoad(s.problem, s.options);
+}
+
+static void runFM(BenchState &s)
+{
+    fmRefine_worker(s.problem, s.options);
+}
+
+static void runQPLinks(BenchState &s)
+{
+    QPLinks(s.problem, s.options, s.QP);
+}
+
+static void runQPGradProj(BenchState &s)
+{
+    QPGradProj(s.problem, s.options, s.QP);
+}
+
+static void runQPNapsack(BenchState &s)
+{
+    QPDelta *QP = s.QP;
+    QPNapsack(QP->x, s.problem->n, QP->lo, QP->hi, s.problem->w, 0.0,
+              QP->FreeSet_status, QP->wx[1], QP->wi[0], QP->wi[1],
+              s.options->gradproj_tolerance);
+}
+
+static void runReadMatrix(BenchState &s)
+{
+    MM_typecode matcode;
+    s.matrix = read_matrix(s.source, matcode);
+}
+
+static void freeMatrix(BenchState &s)
+{
+    if (s.matrix)
+        cs_spfree(s.matrix);
+    s.matrix = NULL;
+}
+
+static const Kernel kernels[] = {
+    { "matching_HEM", false, setupMatching, runHEM, NULL },
+    { "matching_SR", false, setupAfterHEM, runSR, NULL },
+    { "matching_SRdeg", false, setupAfterHEM, runSRdeg, NULL },
+    { "coarsen", false, setupCoarsen, runCoarsen, freeCoarse },
+    { "refine", false, setupRefine, runRefine, freeCoarse },
+    { "bhLoad", false, setupPartition, runBhLoad, NULL },
+    { "fmRefine_worker", false, setupCut, runFM, NULL },
+    { "QPLinks", false, setupQPLinks, runQPLinks, NULL },
+    { "QPGradProj", false, setupQPGradProj, runQPGradProj, NULL },
+    { "QPNapsack", false, setupQPNapsack, runQPNapsack, NULL },
+    { "read_matrix", true, NULL, runReadMatrix, freeMatrix }
+};
+static const int NumKernels = sizeof(kernels) / sizeof(kernels[0]);
+
+/* -------------------------------------------------------------------------- */
+/* Graphs                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static Graph *loadGraph(const std::string &name, std::string &source)
+{
+    if (isGeneratorSpec(name))
+    {
+        source.clear();
+        return generate_graph(name);
+    }
+    source = name;
+    return read_graph(name);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Timing                                                                     */
+/* -------------------------------------------------------------------------- */
+
+/* Nearest-rank percentile of sorted samples */
+static double percentile(const std::vector<double> &sorted, double q)
+{
+    size_t rank = static_cast<size_t>(q * sorted.size() + 0.999999);
+    rank        = std::max(static_cast<size_t>(1), std::min(rank, sorted.size()));
+    return sorted[rank - 1];
+}
+
+static bool timeKernel(const Kernel &kernel, BenchState &s, int warmup,
+                       int repetitions, std::vector<double> &samples)
+{
+    samples.clear();
+    for (int r = 0; r < warmup + repetitions; r++)
+    {
+        if (kernel.setup)
+            kernel.setup(s);
+        int64_t start = Trace::now();
+        kernel.run(s);
+        int64_t end = Trace::now();
+        if (kernel.teardown)
+            kernel.teardown(s);
+        if (r >= warmup)
+            samples.push_back((end - start) / 1e9);
+    }
+    std::sort(samples.begin(), samples.end());
+    return !samples.empty();
+}
+
+static void printKernel(std::ostream &out, const char *name,
+                        const std::vector<double> &samples)
+{
+    double sum = 0;
+    for (size_t k = 0; k < samples.size(); k++)
+        sum += samples[k];
+
+    out << "        { \"Kernel\": \"" << name << "\""
+        << ", \"Min\": " << samples.front()
+        << ", \"Median\": " << percentile(samples, 0.5)
+        << ", \"P90\": " << percentile(samples, 0.9)
+        << ", \"Max\": " << samples.back()
+        << ", \"Mean\": " << sum / samples.size() << " }";
+}
+
+static bool benchmarkGraph(std::ostream &out, const std::string &name,
+                           const std::string &only, int warmup,
+                           int repetitions)
+{
+    BenchState s;
+    s.graph   = loadGraph(name, s.source);
+    s.options = EdgeCut_Options::create();
+    s.problem = (s.graph) ? EdgeCutProblem::create(s.graph) : NULL;
+    s.coarse  = NULL;
+    s.QP      = (s.graph) ? QPDelta::Create(s.graph->n) : NULL;
+    s.y       = (s.graph) ? (double *)SuiteSparse_malloc(
+                          static_cast<size_t>(s.graph->n), sizeof(double))
+                          : NULL;
+    s.matrix  = NULL;
+
+    bool ok = (s.graph && s.options && s.problem && s.QP && s.y);
+    if (ok)
+    {
+        /* Napsack input: a perturbed half split, some of it out of bounds */
+        setRandomSeed(BenchmarkSeed);
+        for (Int k = 0; k < s.graph->n; k++)
+            s.y[k] = (Mongoose::random() % 2001) / 1000.0 - 0.5;
+
+        out << "    { \"Graph\": \"" << name << "\", \"n\": " << s.graph->n
+            << ", \"nz\": " << s.graph->nz << "," << std::endl
+            << "      \"Kernels\": [";
+        bool first = true;
+        for (int k = 0; k < NumKernels; k++)
+        {
+            const Kernel &kernel = kernels[k];
+            std::vector<double> samples;
+            if ((!only.empty() && only != kernel.name)
+                || (kernel.needsFile && s.source.empty())
+                || !timeKernel(kernel, s, warmup, repetitions, samples))
+            {
+                continue;
+            }
+            out << ((first) ? "" : ",") << std::endl;
+            printKernel(out, kernel.name, samples);
+            first = false;
+        }
+        out << ((first) ? "" : "\n      ") << "] }";
+    }
+    else
+    {
+        LogError("Error: Cannot benchmark " << name << "\n");
+    }
+
+    SuiteSparse_free(s.y);
+    if (s.QP)
+    {
+        s.QP->~QPDelta();
+        SuiteSparse_free(s.QP);
+    }
+    if (s.problem)
+        s.problem->~EdgeCutProblem();
+    if (s.options)
+        s.options->~EdgeCut_Options();
+    if (s.graph)
+        s.graph->~Graph();
+    return ok;
+}
+
+int main(int argn, const char **argv)
+{
+    SuiteSparse_start();
+    Logger::setDebugLevel(Error);
+    Logger::setTimingFlag(false);
+
+    int warmup      = 2;
+    int repetitions = 10;
+    std::string only;
+    std::string outputFile;
+    std::vector<std::string> graphs;
+    bool validArguments = true;
+    for (int k = 1; k < argn; k++)
+    {
+        std::string argument = std::string(argv[k]);
+        if (argument.compare(0, 9, "--warmup=") == 0)
+            warmup = atoi(argument.substr(9).c_str());
+        else if (argument.compare(0, 14, "--repetitions=") == 0)
+            repetitions = atoi(argument.substr(14).c_str());
+        else if (argument.compare(0, 9, "--kernel=") == 0)
+            only = argument.substr(9);
+        else if (argument.compare(0, 9, "--output=") == 0)
+            outputFile = argument.substr(9);
+        else if (argument.compare(0, 2, "--") == 0)
+            validArguments = false;
+        else
+            graphs.push_back(argument);
+    }
+
+    bool knownKernel = only.empty();
+    for (int k = 0; k < NumKernels; k++)
+        knownKernel = knownKernel || (only == kernels[k].name);
+
+    if (!validArguments || !knownKernel || warmup < 0 || repetitions < 1)
+    {
+        LogError("Usage: mongoose_benchmark [--warmup=2] [--repetitions=10] "
+                 "[--kernel=name] [--output=file.json] "
+                 "[MM-file.mtx|family:size ...]\n");
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
+    }
+
+    if (graphs.empty())
+    {
+        graphs.push_back("../Matrix/bcspwr10.mtx");
+        graphs.push_back("../Matrix/G51.mtx");
+        graphs.push_back("../Matrix/jagmesh7.mtx");
+        graphs.push_back("../Matrix/Pd.mtx");
+        graphs.push_back("grid2d:512");
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+        file.open(outputFile.c_str(), std::ofstream::out);
+    std::ostream &out = (outputFile.empty()) ? std::cout : file;
+
+    out << "{" << std::endl;
+    out << "  \"Warmup\": " << warmup << "," << std::endl;
+    out << "  \"Repetitions\": " << repetitions << "," << std::endl;
+    out << "  \"Graphs\": [";
+    bool ok    = true;
+    bool first = true;
+    for (size_t g = 0; g < graphs.size(); g++)
+    {
+        std::ostringstream entry;
+        if (!benchmarkGraph(entry, graphs[g], only, warmup, repetitions))
+        {
+            ok = false;
+            continue;
+        }
+        out << ((first) ? "" : ",") << std::endl << entry.str();
+        first = false;
+    }
+    out << std::endl << "  ]" << std::endl << "}" << std::endl;
+
+    SuiteSparse_finish();
+    return (ok && out.good()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,661 @@
+/* ========================================================================== */
+/* === Tests/Mongoose_Regression.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Performance regression harness
+ *
+ * Partitions each graph several times and summarizes, per graph, the mean
+ * and standard deviation of the wall-clock time of edge_cut and of each of
+ * its timed phases, of the peak memory it allocates, and of the cut cost.
+ *
+ *     mongoose_regression [--warmup=1] [--repetitions=10] [--tolerance=0.05]
+ *                         [--record=baseline.json] [--baseline=baseline.json]
+ *                         [graph ...]
+ *
+ * --record writes the summaries as a JSON baseline. --baseline compares them
+ * with a stored baseline and prints a table of the change in every metric
+ * with its 95% confidence interval (Welch's t). A metric is slower (or
+ * faster) if the interval excludes zero and the estimated change exceeds the
+ * tolerance. The harness fails if the total time, the peak memory or the cut
+ * cost is slower; the phases are shown for diagnosis only. A graph is a
+ * Matrix Market file or a generate_graph specification, and with --baseline
+ * the graphs default to those of the baseline.
+ */
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_Generators.hpp"
+#include "Mongoose_IO.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace Mongoose;
+
+/* -------------------------------------------------------------------------- */
+/* Memory tracking                                                            */
+/* -------------------------------------------------------------------------- */
+
+/* Each block is preceded by its size, padded to keep the block aligned. */
+static const size_t HeaderSize = 16;
+
+static std::atomic<int64_t> liveBytes(0);
+static std::atomic<int64_t> peakBytes(0);
+
+static void addBytes(int64_t bytes)
+{
+    int64_t live = (liveBytes += bytes);
+    int64_t peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live))
+    {
+    }
+}
+
+static void *trackedMalloc(size_t size)
+{
+    char *block = (char *)malloc(size + HeaderSize);
+    if (!block)
+        return NULL;
+    memcpy(block, &size, sizeof(size));
+    addBytes(static_cast<int64_t>(size));
+    return block + HeaderSize;
+}
+
+static void *trackedCalloc(size_t count, size_t size)
+{
+    if (size != 0 && count > (SIZE_MAX - HeaderSize) / size)
+        return NULL;
+    void *p = trackedMalloc(count * size);
+    if (p)
+        memset(p, 0, count * size);
+    return p;
+}
+
+static void trackedFree(void *p)
+{
+    if (!p)
+        return;
+    char *block = (char *)p - HeaderSize;
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    addBytes(-static_cast<int64_t>(size));
+    free(block);
+}
+
+static void *trackedRealloc(void *p, size_t newSize)
+{
+    if (!p)
+        return trackedMalloc(newSize);
+    char *block = (char *)p - HeaderSize;
+    size_t oldSize;
+    memcpy(&oldSize, block, sizeof(oldSize));
+    char *newBlock = (char *)realloc(block, newSize + HeaderSize);
+    if (!newBlock)
+        return NULL;
+    memcpy(newBlock, &newSize, sizeof(newSize));
+    addBytes(static_cast<int64_t>(newSize) - static_cast<int64_t>(oldSize));
+    return newBlock + HeaderSize;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Metrics                                                                    */
+/* -------------------------------------------------------------------------- */
+
+enum Metric
+{
+    TotalMetric      = 0,
+    MatchingMetric   = 1,
+    CoarseningMetric = 2,
+    RefinementMetric = 3,
+    FMMetric         = 4,
+    QPMetric         = 5,
+    MemoryMetric     = 6,
+    CutCostMetric    = 7
+};
+static const int NumMetrics = 8;
+
+static const char *const metricNames[] = { "Total",      "Matching",
+                                           "Coarsening", "Refinement",
+                                           "FM",         "QP",
+                                           "PeakMemory", "CutCost" };
+static const char *const metricUnits[] = { "s", "s", "s", "s",
+                                           "s", "s", "B", "" };
+
+/* The metrics that fail the harness when they get worse */
+static bool isChecked(int metric)
+{
+    return metric == TotalMetric || metric == MemoryMetric
+           || metric == CutCostMetric;
+}
+
+struct Summary
+{
+    double mean;
+    double stddev;
+    int samples;
+};
+
+static Summary summarize(const std::vector<double> &values)
+{
+    Summary s;
+    s.samples = static_cast<int>(values.size());
+    double sum = 0;
+    for (size_t k = 0; k < values.size(); k++)
+        sum += values[k];
+    s.mean     = sum / s.samples;
+    double ss  = 0;
+    for (size_t k = 0; k < values.size(); k++)
+        ss += (values[k] - s.mean) * (values[k] - s.mean);
+    s.stddev = (s.samples > 1) ? std::sqrt(ss / (s.samples - 1)) : 0;
+    return s;
+}
+
+/* Two-sided 95% critical value of Student's t with df degrees of freedom */
+static double tCritical(double df)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (!(df >= 1))
+        return table[0];
+    if (df <= 30)
+        return table[static_cast<int>(df) - 1];
+    return 1.960 + 2.4 / df;
+}
+
+/* Change of the current mean relative to the baseline, with its 95%
+ * confidence interval by Welch's t, all as fractions of the baseline mean. */
+struct Change
+{
+    double estimate;
+    double low;
+    double high;
+};
+
+static Change compare(const Summary &base, const Summary &current)
+{
+    double vb = base.stddev * base.stddev / base.samples;
+    double vc = current.stddev * current.stddev / current.samples;
+    double se = std::sqrt(vb + vc);
+    double df = (se > 0) ? (vb + vc) * (vb + vc)
+                               / (vb * vb / std::max(1, base.samples - 1)
+                                  + vc * vc / std::max(1, current.samples - 1))
+                         : 1;
+    double diff  = current.mean - base.mean;
+    double scale = (base.mean != 0) ? std::fabs(base.mean) : 1;
+
+    Change c;
+    c.estimate = diff / scale;
+    c.low      = (diff - tCritical(df) * se) / scale;
+    c.high     = (diff + tCritical(df) * se) / scale;
+    return c;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Measurement                                                                */
+/* -------------------------------------------------------------------------- */
+
+struct GraphResult
+{
+    std::string name;
+    Summary metric[NumMetrics];
+};
+
+static Graph *loadGraph(const std::string &name)
+{
+    return (isGeneratorSpec(name)) ? generate_graph(name) : read_graph(name);
+}
+
+static bool measureGraph(const std::string &name, int warmup, int repetitions,
+                         GraphResult &result)
+{
+    Graph *graph             = loadGraph(name);
+    EdgeCut_Options *options = EdgeCut_Options::create();
+    if (!graph || !options)
+    {
+        LogError("Error: Cannot measure " << name << "\n");
+        if (graph)
+            graph->~Graph();
+        if (options)
+            options->~EdgeCut_Options();
+        return false;
+    }
+
+    static const TimingType phases[] = { MatchingTiming, CoarseningTiming,
+                                         RefinementTiming, FMTiming,
+                                         QPTiming };
+    std::vector<double> values[NumMetrics];
+    bool ok = true;
+    for (int r = 0; r < warmup + repetitions && ok; r++)
+    {
+        float phaseStart[5];
+        for (int p = 0; p < 5; p++)
+            phaseStart[p] = Logger::getTime(phases[p]);
+        int64_t liveStart = liveBytes.load();
+        peakBytes         = liveStart;
+
+        int64_t start = Trace::now();
+        EdgeCut *cut  = edge_cut(graph, options);
+        int64_t end   = Trace::now();
+        if (!cut)
+        {
+            ok = false;
+            break;
+        }
+        double cutCost = cut->cut_cost;
+        cut->~EdgeCut();
+        if (r < warmup)
+            continue;
+
+        values[TotalMetric].push_back((end - start) / 1e9);
+        for (int p = 0; p < 5; p++)
+        {
+            values[MatchingMetric + p].push_back(
+                Logger::getTime(phases[p]) - phaseStart[p]);
+        }
+        values[MemoryMetric].push_back(
+            static_cast<double>(peakBytes.load() - liveStart));
+        values[CutCostMetric].push_back(cutCost);
+    }
+
+    if (ok)
+    {
+        result.name = name;
+        for (int m = 0; m < NumMetrics; m++)
+            result.metric[m] = summarize(values[m]);
+    }
+    else
+    {
+        LogError("Error: edge_cut failed on " << name << "\n");
+    }
+    options->~EdgeCut_Options();
+    graph->~Graph();
+    return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Baselines                                                                  */
+/* -------------------------------------------------------------------------- */
+
+static std::string quote(const std::string &text)
+{
+    std::string quoted = "\"";
+    for (size_t k = 0; k < text.size(); k++)
+    {
+        if (text[k] == '"' || text[k] == '\\')
+            quoted += '\\';
+        quoted += text[k];
+    }
+    return quoted + "\"";
+}
+
+static bool writeBaseline(const std::string &filename,
+                          const std::vector<GraphResult> &results)
+{
+    std::ofstream out(filename.c_str(), std::ofstream::out);
+    out.precision(17);
+    out << "{" << std::endl << "  \"Graphs\": [";
+    for (size_t g = 0; g < results.size(); g++)
+    {
+        out << ((g == 0) ? "" : ",") << std::endl
+            << "    { \"Graph\": " << quote(results[g].name) << ",";
+        for (int m = 0; m < NumMetrics; m++)
+        {
+            const Summary &s = results[g].metric[m];
+            out << ((m == 0) ? "" : ",") << std::endl
+                << "      \"" << metricNames[m] << "\": { \"Mean\": " << s.mean
+                << ", \"StdDev\": " << s.stddev
+                << ", \"Samples\": " << s.samples << " }";
+        }
+        out << " }";
+    }
+    out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    return out.good();
+}
+
+/**
+ * A reader for the subset of JSON that writeBaseline produces: objects,
+ * arrays, strings without escapes other than \" and \\, and numbers.
+ */
+struct JsonValue
+{
+    enum Type
+    {
+        Number,
+        String,
+        Array,
+        Object
+    } type;
+    double number;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::string> keys; /* of an object, parallel to items */
+
+    const JsonValue *get(const std::string &key) const
+    {
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            if (keys[k] == key)
+                return &items[k];
+        }
+        return NULL;
+    }
+};
+
+class JsonReader
+{
+public:
+    JsonReader(const std::string &json)
+        : text(json), s(text.c_str()), end(s + text.size())
+    {
+    }
+
+    bool read(JsonValue &value)
+    {
+        return parseValue(value) && (skipSpace(), s == end);
+    }
+
+private:
+    std::string text;
+    const char *s;
+    const char *end;
+
+    void skipSpace()
+    {
+        while (s < end && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t'))
+            s++;
+    }
+
+    bool parseString(std::string &out)
+    {
+        if (s == end || *s != '"')
+            return false;
+        for (s++; s < end && *s != '"'; s++)
+        {
+            if (*s == '\\' && ++s == end)
+                return false;
+            out += *s;
+        }
+        return s++ < end;
+    }
+
+    bool parseValue(JsonValue &value)
+    {
+        skipSpace();
+        if (s == end)
+            return false;
+        if (*s == '"')
+        {
+            value.type = JsonValue::String;
+            return parseString(value.text);
+        }
+        if (*s == '{' || *s == '[')
+        {
+            bool object = (*s == '{');
+            char close  = (object) ? '}' : ']';
+            value.type  = (object) ? JsonValue::Object : JsonValue::Array;
+            s++;
+            skipSpace();
+            if (s < end && *s == close)
+            {
+                s++;
+                return true;
+            }
+            while (true)
+            {
+                if (object)
+                {
+                    std::string key;
+                    skipSpace();
+                    if (!parseString(key))
+                        return false;
+                    skipSpace();
+                    if (s == end || *s++ != ':')
+                        return false;
+                    value.keys.push_back(key);
+                }
+                value.items.push_back(JsonValue());
+                if (!parseValue(value.items.back()))
+                    return false;
+                skipSpace();
+                if (s < end && *s == ',')
+                {
+                    s++;
+                    continue;
+                }
+                return (s < end && *s++ == close);
+            }
+        }
+        char *numberEnd;
+        value.type   = JsonValue::Number;
+        value.number = strtod(s, &numberEnd);
+        if (numberEnd == s)
+            return false;
+        s = numberEnd;
+        return true;
+    }
+};
+
+static bool readSummary(const JsonValue *entry, Summary &s)
+{
+    const JsonValue *mean    = (entry) ? entry->get("Mean") : NULL;
+    const JsonValue *stddev  = (entry) ? entry->get("StdDev") : NULL;
+    const JsonValue *samples = (entry) ? entry->get("Samples") : NULL;
+    if (!mean || !stddev || !samples || mean->type != JsonValue::Number
+        || stddev->type != JsonValue::Number
+        || samples->type != JsonValue::Number || samples->number < 1)
+        return false;
+    s.mean    = mean->number;
+    s.stddev  = stddev->number;
+    s.samples = static_cast<int>(samples->number);
+    return true;
+}
+
+static bool readBaseline(const std::string &filename,
+                         std::vector<GraphResult> &results)
+{
+    std::ifstream in(filename.c_str());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    if (!in)
+    {
+        LogError("Error: Cannot read baseline " << filename << "\n");
+        return false;
+    }
+
+    JsonValue root;
+    JsonReader reader(contents.str());
+    const JsonValue *graphs = NULL;
+    bool ok = reader.read(root) && root.type == JsonValue::Object
+              && (graphs = root.get("Graphs")) != NULL
+              && graphs->type == JsonValue::Array;
+    for (size_t g = 0; ok && g < graphs->items.size(); g++)
+    {
+        const JsonValue &entry = graphs->items[g];
+        const JsonValue *name  = entry.get("Graph");
+        GraphResult result;
+        ok = (name && name->type == JsonValue::String);
+        if (ok)
+            result.name = name->text;
+        for (int m = 0; ok && m < NumMetrics; m++)
+            ok = readSummary(entry.get(metricNames[m]), result.metric[m]);
+        if (ok)
+            results.push_back(result);
+    }
+    if (!ok)
+        LogError("Error: Invalid baseline " << filename << "\n");
+    return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Comparison                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/* Print the change of every metric of one graph; return false if a checked
+ * metric got worse. */
+static bool printComparison(const GraphResult &base,
+                            const GraphResult &current, double tolerance)
+{
+    bool ok = true;
+    char line[200];
+    snprintf(line, sizeof(line), "  %-11s %14s %14s %9s %21s  %s", "Metric",
+             "Baseline", "Current", "Change", "95% CI", "Verdict");
+    std::cout << current.name << std::endl << line << std::endl;
+    for (int m = 0; m < NumMetrics; m++)
+    {
+        const Summary &b = base.metric[m];
+        const Summary &c = current.metric[m];
+        Change change    = compare(b, c);
+
+        const char *verdict = "same";
+        if (change.low > 0 && change.estimate > tolerance)
+            verdict = (isChecked(m)) ? "SLOWER" : "slower";
+        else if (change.high < 0 && change.estimate < -tolerance)
+            verdict = "faster";
+        if (m == MemoryMetric || m == CutCostMetric)
+        {
+            if (verdict[0] == 'S')
+                verdict = "WORSE";
+            else if (verdict[0] == 'f')
+                verdict = "better";
+        }
+        ok = ok && !(isChecked(m) && change.low > 0
+                     && change.estimate > tolerance);
+
+        snprintf(line, sizeof(line),
+                 "  %-11s %12.4g%-2s %12.4g%-2s %+8.1f%% [%+8.1f%%,%+8.1f%%]"
+                 "  %s",
+                 metricNames[m], b.mean, metricUnits[m], c.mean,
+                 metricUnits[m], 100 * change.estimate, 100 * change.low,
+                 100 * change.high, verdict);
+        std::cout << line << std::endl;
+    }
+    return ok;
+}
+
+int main(int argn, const char **argv)
+{
+    // Track Mongoose's allocations from the start, so that every block is
+    // freed by the same allocator that allocated it.
+    SuiteSparse_start();
+    SuiteSparse_config.malloc_func  = trackedMalloc;
+    SuiteSparse_config.calloc_func  = trackedCalloc;
+    SuiteSparse_config.realloc_func = trackedRealloc;
+    SuiteSparse_config.free_func    = trackedFree;
+    Logger::setDebugLevel(Error);
+    Logger::setTimingFlag(true);
+
+    int warmup       = 1;
+    int repetitions  = 10;
+    double tolerance = 0.05;
+    std::string recordFile;
+    std::string baselineFile;
+    std::vector<std::string> graphs;
+    bool validArguments = true;
+    for (int k = 1; k < argn; k++)
+    {
+        std::string argument = std::string(argv[k]);
+        if (argument.compare(0, 9, "--warmup=") == 0)
+            warmup = atoi(argument.substr(9).c_str());
+        else if (argument.compare(0, 14, "--repetitions=") == 0)
+            repetitions = atoi(argument.substr(14).c_str());
+        else if (argument.compare(0, 12, "--tolerance=") == 0)
+            tolerance = atof(argument.substr(12).c_str());
+        else if (argument.compare(0, 9, "--record=") == 0)
+            recordFile = argument.substr(9);
+        else if (argument.compare(0, 11, "--baseline=") == 0)
+            baselineFile = argument.substr(11);
+        else if (argument.compare(0, 2, "--") == 0)
+            validArguments = false;
+        else
+            graphs.push_back(argument);
+    }
+
+    if (!validArguments || warmup < 0 || repetitions < 2 || tolerance < 0
+        || (recordFile.empty() && baselineFile.empty()))
+    {
+        LogError("Usage: mongoose_regression [--warmup=1] [--repetitions=10] "
+                 "[--tolerance=0.05] [--record=baseline.json] "
+                 "[--baseline=baseline.json] [graph ...]\n");
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<GraphResult> baseline;
+    if (!baselineFile.empty() && !readBaseline(baselineFile, baseline))
+    {
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
+    }
+    if (graphs.empty())
+    {
+        for (size_t g = 0; g < baseline.size(); g++)
+            graphs.push_back(baseline[g].name);
+    }
+    if (graphs.empty())
+    {
+        graphs.push_back("../Matrix/bcspwr10.mtx");
+        graphs.push_back("../Matrix/G51.mtx");
+        graphs.push_back("../Matrix/jagmesh7.mtx");
+        graphs.push_back("../Matrix/Pd.mtx");
+        graphs.push_back("mesh2d:300");
+    }
+
+    bool ok = true;
+    std::vector<GraphResult> results;
+    for (size_t g = 0; g < graphs.size(); g++)
+    {
+        GraphResult result;
+        if (!measureGraph(graphs[g], warmup, repetitions, result))
+        {
+            ok = false;
+            continue;
+        }
+        results.push_back(result);
+
+        if (baselineFile.empty())
+            continue;
+        const GraphResult *base = NULL;
+        for (size_t b = 0; b < baseline.size() && !base; b++)
+        {
+            if (baseline[b].name == result.name)
+                base = &baseline[b];
+        }
+        if (!base)
+        {
+            std::cout << result.name << ": not in the baseline" << std::endl;
+            continue;
+        }
+        ok = printComparison(*base, result, tolerance) && ok;
+    }
+
+    if (!recordFile.empty() && !writeBaseline(recordFile, results))
+    {
+        LogError("Error: Cannot write baseline " << recordFile << "\n");
+        ok = false;
+    }
+
+    SuiteSparse_finish();
+    return (ok) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
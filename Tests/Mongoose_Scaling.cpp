@@ -0,0 +1,260 @@
+/* ========================================================================== */
+/* === Tests/Mongoose_Scaling.cpp =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Scaling benchmark on generated graphs
+ *
+ * Sweeps over graph sizes and thread counts without reading any files: each
+ * graph is generated, then partitioned with the default options, and the
+ * fastest of the repeated generation and partitioning times are written as
+ * JSON for every size and number of threads.
+ *
+ *     mongoose_scaling [--threads=1,2,4] [--repetitions=3]
+ *                      [--output=file.json] [--write=directory]
+ *                      [family:size[,size ...][:seed] ...]
+ *
+ * The families are those of generate_graph, so rmat:16,18,20 sweeps R-MAT
+ * graphs of 2^16, 2^18 and 2^20 vertices. By default the number of threads
+ * doubles from 1 up to the number of hardware threads. With --write, each
+ * graph is also saved as a Mongoose binary graph file (family_size.bin) for
+ * use by other tools.
+ */
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_Generators.hpp"
+#include "Mongoose_IO.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_Trace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Mongoose;
+
+/* Parse a comma separated list of positive integers. */
+static bool parseList(const std::string &list, std::vector<Int> &values)
+{
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        char *end;
+        long long value = strtoll(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value < 1)
+            return false;
+        values.push_back(static_cast<Int>(value));
+    }
+    return !values.empty();
+}
+
+/* Expand family:s1,s2,...[:seed] into one generate_graph spec per size. */
+static bool expandSweep(const std::string &sweep,
+                        std::vector<std::string> &specs)
+{
+    size_t colon = sweep.find(':');
+    if (colon == std::string::npos)
+        return false;
+    size_t seedColon = sweep.find(':', colon + 1);
+    std::string family = sweep.substr(0, colon);
+    std::string sizes  = sweep.substr(colon + 1, seedColon - colon - 1);
+    std::string seed   = (seedColon == std::string::npos)
+                           ? ""
+                           : sweep.substr(seedColon);
+
+    std::vector<Int> values;
+    if (!parseList(sizes, values))
+        return false;
+    for (size_t k = 0; k < values.size(); k++)
+    {
+        std::ostringstream spec;
+        spec << family << ":" << values[k] << seed;
+        if (!isGeneratorSpec(spec.str()))
+            return false;
+        specs.push_back(spec.str());
+    }
+    return true;
+}
+
+/* Sweep the thread counts on one graph, writing one JSON entry per count. */
+static bool sweepGraph(std::ostream &out, const std::string &spec,
+                       const std::vector<Int> &threads, int repetitions,
+                       const std::string &directory, bool &first)
+{
+    EdgeCut_Options *options = EdgeCut_Options::create();
+    if (!options)
+        return false;
+
+    bool ok = true;
+    for (size_t t = 0; t < threads.size() && ok; t++)
+    {
+        threadLimit() = static_cast<size_t>(threads[t]);
+
+        double generateTime  = 0;
+        double partitionTime = 0;
+        Graph *graph         = NULL;
+        EdgeCut *cut         = NULL;
+        for (int r = 0; r < repetitions && ok; r++)
+        {
+            if (graph)
+                graph->~Graph();
+            if (cut)
+                cut->~EdgeCut();
+            cut = NULL;
+
+            int64_t start = Trace::now();
+            graph         = generate_graph(spec);
+            int64_t end   = Trace::now();
+            if (!graph)
+            {
+                ok = false;
+                break;
+            }
+            double time  = (end - start) / 1e9;
+            generateTime = (r == 0) ? time : std::min(generateTime, time);
+
+            start = Trace::now();
+            cut   = edge_cut(graph, options);
+            end   = Trace::now();
+            if (!cut)
+            {
+                ok = false;
+                break;
+            }
+            time          = (end - start) / 1e9;
+            partitionTime = (r == 0) ? time : std::min(partitionTime, time);
+        }
+
+        if (ok)
+        {
+            out << ((first) ? "" : ",") << std::endl
+                << "    { \"Graph\": \"" << spec << "\", \"n\": " << graph->n
+                << ", \"nz\": " << graph->nz << ", \"Threads\": " << threads[t]
+                << ", \"GenerateTime\": " << generateTime
+                << ", \"PartitionTime\": " << partitionTime
+                << ", \"CutCost\": " << cut->cut_cost
+                << ", \"Imbalance\": " << cut->imbalance << " }";
+            first = false;
+        }
+
+        if (ok && !directory.empty() && t == 0)
+        {
+            std::string name = spec;
+            std::replace(name.begin(), name.end(), ':', '_');
+            ok = write_graph_binary(graph, directory + "/" + name + ".bin");
+        }
+
+        if (graph)
+            graph->~Graph();
+        if (cut)
+            cut->~EdgeCut();
+    }
+
+    threadLimit() = 0;
+    options->~EdgeCut_Options();
+    if (!ok)
+        LogError("Error: Cannot benchmark " << spec << "\n");
+    return ok;
+}
+
+int main(int argn, const char **argv)
+{
+    SuiteSparse_start();
+    Logger::setDebugLevel(Error);
+    Logger::setTimingFlag(false);
+
+    int repetitions = 3;
+    std::string outputFile;
+    std::string directory;
+    std::vector<Int> threads;
+    std::vector<std::string> specs;
+    bool validArguments = true;
+    for (int k = 1; k < argn; k++)
+    {
+        std::string argument = std::string(argv[k]);
+        if (argument.compare(0, 10, "--threads=") == 0)
+            validArguments = parseList(argument.substr(10), threads)
+                             && validArguments;
+        else if (argument.compare(0, 14, "--repetitions=") == 0)
+            repetitions = atoi(argument.substr(14).c_str());
+        else if (argument.compare(0, 9, "--output=") == 0)
+            outputFile = argument.substr(9);
+        else if (argument.compare(0, 8, "--write=") == 0)
+            directory = argument.substr(8);
+        else if (argument.compare(0, 2, "--") == 0)
+            validArguments = false;
+        else
+            validArguments = expandSweep(argument, specs) && validArguments;
+    }
+
+    if (!validArguments || repetitions < 1)
+    {
+        LogError("Usage: mongoose_scaling [--threads=1,2,4] "
+                 "[--repetitions=3] [--output=file.json] "
+                 "[--write=directory] "
+                 "[family:size[,size ...][:seed] ...]\n");
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
+    }
+
+    Int hardwareThreads = static_cast<Int>(maxThreads());
+    if (threads.empty())
+    {
+        for (Int t = 1; t < hardwareThreads; t *= 2)
+            threads.push_back(t);
+        threads.push_back(hardwareThreads);
+    }
+
+    if (specs.empty())
+    {
+        expandSweep("grid2d:256,512,1024", specs);
+        expandSweep("grid3d:32,64,128", specs);
+        expandSweep("mesh3d:32,64", specs);
+        expandSweep("geo2d:100000,400000", specs);
+        expandSweep("rmat:14,16,18", specs);
+        expandSweep("er:100000,400000", specs);
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+        file.open(outputFile.c_str(), std::ofstream::out);
+    std::ostream &out = (outputFile.empty()) ? std::cout : file;
+
+    out << "{" << std::endl;
+    out << "  \"Repetitions\": " << repetitions << "," << std::endl;
+    out << "  \"HardwareThreads\": " << hardwareThreads << "," << std::endl;
+    out << "  \"Runs\": [";
+    bool ok    = true;
+    bool first = true;
+    for (size_t s = 0; s < specs.size(); s++)
+    {
+        std::ostringstream entries;
+        bool firstEntry = first;
+        if (!sweepGraph(entries, specs[s], threads, repetitions, directory,
+                        firstEntry))
+        {
+            ok = false;
+            continue;
+        }
+        out << entries.str();
+        first = firstEntry;
+    }
+    out << std::endl << "  ]" << std::endl << "}" << std::endl;
+
+    SuiteSparse_finish();
+    return (ok && out.good()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -8,9 +8,39 @@
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_IO.hpp"
 #include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_MemoryProfiler.hpp"
+#include "Mongoose_OpCounters.hpp"
+#include "Mongoose_Parallel.hpp"
+#include "Mongoose_PerfCounters.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_Trace.hpp"
+#include <cmath>
+#include <cstring>
+#include <thread>
 
 using namespace Mongoose;
 
+/* Gradient projection iterations at the finest levels of a cut */
+static Int qpIterations(const EdgeCut *cut, Int numLevels)
+{
+    Int iterations = 0;
+    for (Int k = 0; k < numLevels && k < cut->num_levels; k++)
+        iterations += cut->level_stats[k].qp_iterations;
+    return iterations;
+}
+
+/* The cut cost plus the balance penalty of a cut, weighed as the heuristic
+ * cost of edge_cut: twice the cut cost, plus the imbalance times H once the
+ * imbalance exceeds the soft split tolerance */
+static double heuCost(const EdgeCut *cut, const EdgeCut_Options *options,
+                      double H)
+{
+    double penalty = (cut->imbalance > options->soft_split_tolerance)
+                         ? cut->imbalance * H
+                         : 0;
+    return 2 * cut->cut_cost + penalty;
+}
+
 int main(int argn, char** argv)
 {
     (void)argn; // Unused variable
@@ -57,6 +87,66 @@ int main(int argn, char** argv)
     assert(result == NULL);
     O->num_dances = 1;
 
+    // Test with invalid waterdance_min_payoff
+    O->waterdance_min_payoff = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->waterdance_min_payoff = 0.01;
+
+    // Test with invalid waterdance_max_dances
+    O->waterdance_max_dances = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->waterdance_max_dances = 4;
+
+    // Test with invalid waterdance_time_budget
+    O->waterdance_time_budget = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->waterdance_time_budget = 0;
+
+    // Test with invalid num_cycles
+    O->num_cycles = 0;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->num_cycles = 1;
+
+    // Test with invalid cycle_min_improvement
+    O->cycle_min_improvement = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->cycle_min_improvement = 0.001;
+
+    // Test with invalid cycle_time_budget
+    O->cycle_time_budget = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->cycle_time_budget = 0;
+
+    // Test with invalid evolution_population
+    O->evolution_population = 1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->evolution_population = 8;
+
+    // Test with invalid evolution_generations
+    O->evolution_generations = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->evolution_generations = 16;
+
+    // Test with invalid evolution_mutation_rate
+    O->evolution_mutation_rate = 2;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->evolution_mutation_rate = 0.1;
+
+    // Test with invalid evolution_time_budget
+    O->evolution_time_budget = -1;
+    result = edge_cut(G, O);
+    assert(result == NULL);
+    O->evolution_time_budget = 0;
+
     // Test with invalid FM_search_depth
     O->FM_search_depth = -1;
     result = edge_cut(G, O);
@@ -105,6 +195,125 @@ int main(int argn, char** argv)
     result->~EdgeCut();
     O->use_QP_gradproj = true;
 
+    // The QP options below are compared on a graph with several levels
+    Graph *J = read_graph("../Matrix/jagmesh7.mtx");
+    if (!J)
+        return EXIT_FAILURE;
+    O->collect_stats   = true;
+    EdgeCut *reference = edge_cut(J, O);
+    assert(reference->num_levels > 2);
+
+    // Test with single precision QP, which may only move a few vertices
+    // near 0.5: the cut cost must be within 5% of the double precision one,
+    // and the imbalance within the soft split tolerance
+    O->use_QP_single_precision = true;
+    result = edge_cut(J, O);
+    assert(result->partition != NULL);
+    assert(fabs(result->cut_cost - reference->cut_cost)
+           <= 0.05 * reference->cut_cost);
+    assert(fabs(result->imbalance - reference->imbalance)
+           <= O->soft_split_tolerance);
+    result->~EdgeCut();
+    O->use_QP_single_precision = false;
+
+    // Test with QP solutions prolonged across levels, which start the finest
+    // level near its solution: fewer iterations there, and no worse a cut
+    O->use_QP_prolongation = true;
+    result = edge_cut(J, O);
+    assert(result->partition != NULL);
+    assert(qpIterations(result, 1) < qpIterations(reference, 1));
+    assert(result->cut_cost <= reference->cut_cost);
+    result->~EdgeCut();
+    O->use_QP_prolongation = false;
+
+    // Test with the adaptive waterdance, with and without a time budget.
+    // With a payoff no refiner can reach, QP only runs on every other level
+    // to measure its payoff again, so it makes fewer iterations than with
+    // the fixed schedule.
+    O->use_adaptive_waterdance = true;
+    result = edge_cut(G, O);
+    assert(result->partition != NULL);
+    result->~EdgeCut();
+    O->waterdance_min_payoff = 1E30;
+    result = edge_cut(J, O);
+    assert(result->partition != NULL);
+    assert(qpIterations(result, result->num_levels) > 0);
+    assert(qpIterations(result, result->num_levels)
+           < qpIterations(reference, reference->num_levels));
+    result->~EdgeCut();
+    O->waterdance_min_payoff  = 0.01;
+    O->waterdance_time_budget = 1E-9;
+    result = edge_cut(G, O);
+    assert(result->partition != NULL);
+    result->~EdgeCut();
+    O->waterdance_time_budget  = 0;
+    O->use_adaptive_waterdance = false;
+    O->collect_stats           = false;
+    reference->~EdgeCut();
+    J->~Graph();
+    (void)qpIterations; // Unused function if NDEBUG
+
+    // Test with V-cycles and F-cycles, which never raise the heuristic cost
+    // of the first cycle
+    O->coarsen_limit = 8;
+    double H         = 0;
+    for (Int p = 0; p < G->nz; p++)
+        H += 2 * ((G->x) ? G->x[p] : 1);
+    EdgeCut *single          = edge_cut(G, O);
+    double singleCost        = heuCost(single, O, H);
+    O->num_cycles            = 8;
+    O->cycle_min_improvement = 0;
+    for (int type = Cycle_V; type <= Cycle_F; type++)
+    {
+        O->cycle_type = static_cast<CycleType>(type);
+        result        = edge_cut(G, O);
+        assert(result->partition != NULL);
+        assert(heuCost(result, O, H) <= singleCost + 1E-9);
+        result->~EdgeCut();
+    }
+    O->cycle_time_budget = 1E-9;
+    result = edge_cut(G, O);
+    assert(result->partition != NULL);
+    result->~EdgeCut();
+    O->cycle_time_budget     = 0;
+    O->cycle_min_improvement = 0.001;
+    O->num_cycles            = 1;
+    O->cycle_type            = Cycle_V;
+
+    // Test the evolution, whose best cut has no higher a heuristic cost than
+    // the first member of its population (the cut above), on one thread and
+    // on all of them.
+    // The phases timed on worker threads are charged to this thread.
+    O->use_evolution         = true;
+    O->evolution_generations = 4;
+    threadLimit()            = 1;
+    EdgeCut *serial          = edge_cut(G, O);
+    threadLimit()            = 0;
+    Logger::setTimingFlag(true);
+    float coarsening = Logger::getTime(CoarseningTiming);
+    result           = edge_cut(G, O);
+    Logger::setTimingFlag(false);
+    assert(Logger::getTime(CoarseningTiming) > coarsening);
+    (void)coarsening; // Unused variable if NDEBUG
+    assert(result->partition != NULL && result->num_levels == 0);
+    assert(heuCost(result, O, H) <= singleCost + 1E-9);
+    assert(memcmp(result->partition, serial->partition,
+                  static_cast<size_t>(G->n) * sizeof(bool))
+           == 0);
+    result->~EdgeCut();
+    serial->~EdgeCut();
+    O->evolution_time_budget = 1E-9;
+    result = edge_cut(G, O);
+    assert(result->partition != NULL);
+    result->~EdgeCut();
+    single->~EdgeCut();
+    (void)heuCost;    // Unused function if NDEBUG
+    (void)singleCost; // Unused variable if NDEBUG
+    O->evolution_time_budget = 0;
+    O->evolution_generations = 16;
+    O->use_evolution         = false;
+    O->coarsen_limit         = 50;
+
     // Test with no FM
     O->use_FM = false;
     result = edge_cut(G, O);
@@ -112,6 +321,174 @@ int main(int argn, char** argv)
     result->~EdgeCut();
     O->use_FM = true;
 
+    // Test with tracing, coarsening down to a few vertices
+    O->coarsen_limit = 8;
+    Trace::setTracingFlag(true);
+    result = edge_cut(G, O);
+    Trace::setTracingFlag(false);
+    assert(result->partition != NULL);
+    result->~EdgeCut();
+    Int numSpans = Trace::getNumSpans();
+    assert(numSpans > 0);
+    result = edge_cut(G, O);
+    result->~EdgeCut();
+    assert(Trace::getNumSpans() == numSpans);
+    bool written = Trace::writeChromeTrace("edgesep_trace.json");
+    assert(written);
+    (void)numSpans; // Unused variable if NDEBUG
+    (void)written;  // Unused variable if NDEBUG
+    FILE *file = fopen("edgesep_trace.json", "r");
+    char line[32] = { 0 };
+    if (!file || !fgets(line, sizeof(line), file))
+        return EXIT_FAILURE;
+    fclose(file);
+    assert(strcmp(line, "{\"traceEvents\":[\n") == 0);
+    remove("edgesep_trace.json");
+    Trace::clear();
+    assert(Trace::getNumSpans() == 0);
+
+    // Test with hardware counters, which may be unavailable
+    double counts[PerfCounters::NumCounters];
+    bool counting = PerfCounters::setCountingFlag(true);
+    result = edge_cut(G, O);
+    result->~EdgeCut();
+    assert(PerfCounters::getCounts(MatchingTiming, 0, counts) == counting);
+    assert(!PerfCounters::getCounts(MatchingTiming, 1000, counts));
+    (void)counts;   // Unused variable if NDEBUG
+    (void)counting; // Unused variable if NDEBUG
+    PerfCounters::setCountingFlag(false);
+    PerfCounters::clear();
+    assert(!PerfCounters::isCounting());
+
+    // Test with statistics of each level
+    result = edge_cut(G, O);
+    assert(result->num_levels == 0 && result->level_stats == NULL);
+    result->~EdgeCut();
+    O->collect_stats = true;
+    result = edge_cut(G, O);
+    assert(result->num_levels > 1 && result->level_stats != NULL);
+    assert(result->level_stats[0].n == G->n);
+    for (Int k = 0; k + 1 < result->num_levels; k++)
+    {
+        const EdgeCut_LevelStats &stats = result->level_stats[k];
+        assert(stats.match_count[0] + stats.match_count[1]
+                   + stats.match_count[2] + stats.match_count[3]
+               == stats.n);
+        assert(stats.contraction < 1);
+        assert(result->level_stats[k + 1].cut_cost_after
+               == stats.cut_cost_before);
+        (void)stats; // Unused variable if NDEBUG
+    }
+    assert(result->level_stats[0].cut_cost_after == result->cut_cost);
+    assert(result->level_stats[result->num_levels - 1].contraction == 1);
+    result->~EdgeCut();
+    O->collect_stats = false;
+
+    // Test the operation counters, which count only if compiled in
+    int64_t ops[OpCounters::NumOperations];
+    OpCounters::clear();
+    result = edge_cut(G, O);
+    result->~EdgeCut();
+    OpCounters::getCounts(ops);
+    assert((ops[HeapInsertOp] > 0) == OpCounters::isEnabled());
+    assert((ops[CoarsenHashMissOp] > 0) == OpCounters::isEnabled());
+    assert(ops[HeapRemoveOp] <= ops[HeapInsertOp]);
+    OpCounters::clear();
+    OpCounters::getCounts(ops);
+    assert(ops[HeapInsertOp] == 0);
+
+    // Test the memory profiler, with a block allocated before it started
+    void *before = SuiteSparse_malloc(100, sizeof(Int));
+    bool profiling = MemoryProfiler::setProfilingFlag(true);
+    assert(profiling);
+    MemoryProfiler::clear();
+    O->collect_stats = true;
+    result = edge_cut(G, O);
+    assert(MemoryProfiler::getPeakBytes() > 0);
+    assert(result->level_stats[0].allocations > 0);
+    assert(result->level_stats[0].peak_bytes > 0);
+    MemoryCounts memory;
+    bool recorded = MemoryProfiler::getCounts(CoarseningTiming, 0, memory);
+    assert(recorded);
+    assert(memory.allocations > 0 && memory.bytes > 0);
+    (void)recorded; // Unused variable if NDEBUG
+    assert(!MemoryProfiler::getCounts(CoarseningTiming, 1000, memory));
+    result->~EdgeCut();
+    SuiteSparse_free(before);
+    assert(MemoryProfiler::getCurrentBytes() == 0);
+
+    // Test concurrent edge cuts with the memory profiler, on a graph large
+    // enough for them to overlap: each must get the allocations of its own
+    // levels, as a cut made on its own does
+    Graph *P = read_graph("../Matrix/bcspwr10.mtx");
+    if (!P)
+        return EXIT_FAILURE;
+    EdgeCut *profiled[3];
+    profiled[2] = edge_cut(P, O);
+    std::thread profiledWorker([&] { profiled[0] = edge_cut(P, O); });
+    profiled[1] = edge_cut(P, O);
+    profiledWorker.join();
+    for (int t = 0; t < 2; t++)
+    {
+        assert(profiled[t] != NULL);
+        assert(profiled[t]->num_levels == profiled[2]->num_levels);
+        for (Int k = 0; k < profiled[2]->num_levels; k++)
+        {
+            assert(profiled[t]->level_stats[k].allocations
+                   == profiled[2]->level_stats[k].allocations);
+            assert(profiled[t]->level_stats[k].allocated_bytes
+                   == profiled[2]->level_stats[k].allocated_bytes);
+        }
+    }
+    for (int t = 0; t < 3; t++)
+        profiled[t]->~EdgeCut();
+    P->~Graph();
+    O->collect_stats = false;
+    profiling        = MemoryProfiler::setProfilingFlag(false);
+    assert(!profiling);
+    (void)profiling; // Unused variable if NDEBUG
+
+    // Test concurrent edge cuts from random guess cuts, which must match a
+    // cut made on its own
+    EdgeCut *alone = edge_cut(G, O);
+    EdgeCut *concurrent[2];
+    std::thread worker([&] { concurrent[0] = edge_cut(G, O); });
+    concurrent[1] = edge_cut(G, O);
+    worker.join();
+    for (int t = 0; t < 2; t++)
+    {
+        assert(concurrent[t] != NULL);
+        assert(concurrent[t]->cut_cost == alone->cut_cost);
+        assert(memcmp(concurrent[t]->partition, alone->partition,
+                      G->n * sizeof(bool))
+               == 0);
+        concurrent[t]->~EdgeCut();
+    }
+    alone->~EdgeCut();
+    O->coarsen_limit = 50;
+
+    // Test the random numbers, which depend only on their arguments
+    uint64_t key = randomKey(O->random_seed, 3);
+    assert(key != randomKey(O->random_seed, 4));
+    assert(key != randomKey(O->random_seed + 1, 3));
+    assert(randomBits(key, 10) == randomBits(key, 10));
+    assert(randomBits(key, 10) != randomBits(key, 10, 1));
+    for (Int k = 0; k < 1000; k++)
+    {
+        double u = randomUniform(key, k);
+        Int index = randomIndex(key, k, 0, 7);
+        assert(u >= 0 && u < 1 && index >= 0 && index < 7);
+        (void)u;     // Unused variable if NDEBUG
+        (void)index; // Unused variable if NDEBUG
+    }
+    setRandomSeed(7);
+    Int first  = Mongoose::random();
+    Int second = Mongoose::random();
+    setRandomSeed(7);
+    assert(Mongoose::random() == first && Mongoose::random() == second);
+    (void)first;  // Unused variable if NDEBUG
+    (void)second; // Unused variable if NDEBUG
+
     // Test with no coarsening
     O->coarsen_limit = 1E15;
     result = edge_cut(G, O);
@@ -8,6 +8,12 @@
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_IO.hpp"
 #include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Components.hpp"
+#include "Mongoose_Generators.hpp"
+#include "Mongoose_Parallel.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace Mongoose;
 
@@ -71,6 +77,135 @@ int main(int argn, char** argv)
     Graph *G7 = Graph::create(M4);
     assert(G7 != NULL);
 
+    // Connected components of a disconnected graph (Erdos971 has 42)
+    Graph *E = read_graph("../Matrix/Erdos971.mtx");
+    if (!E)
+        return EXIT_FAILURE;
+    Int *component = (Int *)SuiteSparse_malloc(E->n, sizeof(Int));
+    Int *vertex_map = (Int *)SuiteSparse_malloc(E->n, sizeof(Int));
+    Int numComponents = connected_components(E, component);
+    assert(numComponents == 42);
+    (void)numComponents; // Unused variable if NDEBUG
+    assert(component[0] == 0);
+    Graph *L = largest_component(E, vertex_map);
+    if (!L)
+        return EXIT_FAILURE;
+    assert(L->n == 429);
+    for (Int k = 1; k < L->n; k++)
+        assert(vertex_map[k] > vertex_map[k - 1]);
+
+    EdgeCut_Options *options = EdgeCut_Options::create();
+    options->component_strategy = Components_Largest;
+    EdgeCut *cut = edge_cut(E, options);
+    if (!cut)
+        return EXIT_FAILURE;
+    assert(cut->n == L->n && cut->vertex_map != NULL);
+    for (Int k = 0; k < cut->n; k++)
+        assert(cut->vertex_map[k] == vertex_map[k]);
+    cut->~EdgeCut();
+
+    options->component_strategy = Components_BinPack;
+    cut = edge_cut(E, options);
+    if (!cut)
+        return EXIT_FAILURE;
+    assert(cut->n == E->n && cut->vertex_map == NULL);
+    assert(cut->w0 + cut->w1 == E->n);
+    assert(cut->imbalance < 0.01);
+    cut->~EdgeCut();
+
+    options->~EdgeCut_Options();
+    L->~Graph();
+    E->~Graph();
+    SuiteSparse_free(component);
+    SuiteSparse_free(vertex_map);
+
+    // Generated graphs: sizes of the stencils, and determinism of the
+    // random graphs
+    Graph *grid = generate_grid(4, 3, 2);
+    assert(grid != NULL);
+    assert(grid->n == 24 && grid->nz == 2 * (18 + 16 + 12));
+    grid->~Graph();
+    Graph *mesh = generate_graph("mesh2d:5");
+    assert(mesh != NULL);
+    assert(mesh->n == 25 && mesh->nz == 2 * (2 * 20 + 2 * 16));
+    mesh->~Graph();
+
+    const char *randomSpecs[] = { "geo2d:300", "geo3d:300:7", "rmat:7",
+                                  "er:300" };
+    for (int k = 0; k < 4; k++)
+    {
+        Graph *R1 = generate_graph(randomSpecs[k]);
+        Graph *R2 = generate_graph(randomSpecs[k]);
+        assert(R1 != NULL && R2 != NULL);
+        assert(R1->nz > 0 && R1->n == R2->n && R1->nz == R2->nz);
+        for (Int j = 0; j < R1->n; j++)
+        {
+            assert(R1->p[j + 1] == R2->p[j + 1]);
+            for (Int p = R1->p[j]; p < R1->p[j + 1]; p++)
+                assert(R1->i[p] == R2->i[p] && R1->i[p] != j);
+        }
+        R1->~Graph();
+        R2->~Graph();
+    }
+    assert(generate_graph("grid2d") == NULL);
+    assert(generate_graph("cube:10") == NULL);
+    assert(generate_rmat(10, 16, 0.6, 0.3, 0.3) == NULL);
+
+    // Test the thread pool: every index visited once, nested loops, reduce
+    for (size_t limit = 0; limit <= 1; limit++)
+    {
+        threadLimit() = limit;
+        const Int n   = 100000;
+        std::vector<int> visits(n, 0);
+        parallelFor(0, n, 1000, [&](Int k0, Int k1) {
+            parallelFor(k0, k1, 10, [&](Int j0, Int j1) {
+                for (Int k = j0; k < j1; k++)
+                    visits[k]++;
+            });
+        });
+        for (Int k = 0; k < n; k++)
+            assert(visits[k] == 1);
+        Int sum = parallelReduce(
+            0, n, 1000, static_cast<Int>(0),
+            [&](Int k0, Int k1) {
+                Int partial = 0;
+                for (Int k = k0; k < k1; k++)
+                    partial += visits[k] * k;
+                return partial;
+            },
+            [](Int a, Int b) { return a + b; });
+        assert(sum == n * (n - 1) / 2);
+        (void)sum; // Unused variable if NDEBUG
+        assert(parallelReduce(
+                   5, 5, 1, static_cast<Int>(7),
+                   [](Int, Int) { return static_cast<Int>(1); },
+                   [](Int a, Int b) { return a + b; })
+               == 7);
+
+        std::atomic<Int> spawned(0);
+        TaskGroup group;
+        for (int t = 0; t < 64; t++)
+            group.spawn([&] { spawned++; });
+        group.wait();
+        assert(spawned == 64);
+    }
+
+    // Test that a loop never runs on more threads than the limit
+    threadLimit() = 2;
+    std::atomic<int> active(0);
+    std::atomic<int> peak(0);
+    parallelFor(0, 64, 1, [&](Int, Int) {
+        int now = ++active;
+        int seen = peak;
+        while (now > seen && !peak.compare_exchange_weak(seen, now))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        active--;
+    });
+    assert(peak >= 1 && peak <= 2);
+    threadLimit() = 0;
+
     // Tests to increase coverage
     /* Override SuiteSparse memory management with custom testers. */
     SuiteSparse_config.malloc_func = myMalloc;
@@ -1,6 +1,10 @@
 #include "Mongoose_Test.hpp"
 #include "Mongoose_IO.hpp"
+#include "Mongoose_Hierarchy.hpp"
 #include "Mongoose_Sanitize.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 using namespace Mongoose;
 
@@ -46,6 +50,14 @@ int main(int argn, char** argv)
     G = read_graph("../Tests/Matrix/Trec4.mtx");
     assert (G == NULL);
 
+    // Entry with an index out of range
+    G = read_graph("../Tests/Matrix/bad_entry.mtx");
+    assert (G == NULL);
+
+    // Fewer entries than the header declares
+    G = read_graph("../Tests/Matrix/truncated.mtx");
+    assert (G == NULL);
+
     // C-style string filename
     MM_typecode matcode;
     std::string filename = "../Matrix/bcspwr01.mtx";
@@ -59,6 +71,341 @@ int main(int argn, char** argv)
     }
     SuiteSparse_free(M);
 
+    // Fused sanitize of an unsymmetric matrix matches the cs_add path
+    M = read_matrix("../Matrix/Pd.mtx", matcode);
+    if (!M)
+        return EXIT_FAILURE;
+    cs *S = sanitizeMatrix(M, false, false);
+    cs_spfree(M);
+    G = read_graph("../Matrix/Pd.mtx");
+    if (!S || !G)
+        return EXIT_FAILURE;
+    assert(G->n == S->n && G->nz == S->p[S->n]);
+    for (Int k = 0; k <= G->n; k++)
+        assert(G->p[k] == S->p[k]);
+    for (Int k = 0; k < G->nz; k++)
+    {
+        assert(G->i[k] == S->i[k]);
+        assert(G->x[k] == S->x[k]);
+    }
+    cs_spfree(S);
+    G->~Graph();
+
+    // Binary graph round trip, with native and compact indices
+    G = read_graph("../Matrix/jagmesh7.mtx");
+    assert(G != NULL);
+    for (int compact = 0; compact < 2; compact++)
+    {
+        bool written = write_graph_binary(G, "jagmesh7.mgb", compact);
+        assert(written);
+        (void)written; // Unused variable if NDEBUG
+        Graph *B = read_graph_binary("jagmesh7.mgb");
+        if (!B)
+            return EXIT_FAILURE;
+        assert(B->n == G->n && B->nz == G->nz);
+        assert((B->x == NULL) == (G->x == NULL));
+        assert(B->w == NULL);
+        for (Int k = 0; k <= G->n; k++)
+            assert(B->p[k] == G->p[k]);
+        for (Int k = 0; k < G->nz; k++)
+        {
+            assert(B->i[k] == G->i[k]);
+            assert(B->x == NULL || B->x[k] == G->x[k]);
+        }
+        B->~Graph();
+    }
+
+    // Corrupt binary graph files: a vertex count too large for the file, a
+    // column pointer out of order, and a row index out of range. The header
+    // is 64 bytes, with n at byte 24, followed by p and then i.
+    {
+        bool written = write_graph_binary(G, "jagmesh7.mgb", false);
+        assert(written);
+        (void)written; // Unused variable if NDEBUG
+        long offsets[3] = { 24, 64 + 8, 64 + 8 * (G->n + 1) };
+        int64_t values[3] = { INT64_MAX / 2, G->nz + 1, G->n };
+        for (int c = 0; c < 3; c++)
+        {
+            FILE *file = fopen("jagmesh7.mgb", "r+b");
+            assert(file != NULL);
+            int64_t saved;
+            fseek(file, offsets[c], SEEK_SET);
+            size_t count = fread(&saved, sizeof(int64_t), 1, file);
+            assert(count == 1);
+            (void)count; // Unused variable if NDEBUG
+            fseek(file, offsets[c], SEEK_SET);
+            fwrite(&values[c], sizeof(int64_t), 1, file);
+            fclose(file);
+
+            Graph *B = read_graph_binary("jagmesh7.mgb");
+            assert(B == NULL);
+            (void)B; // Unused variable if NDEBUG
+
+            file = fopen("jagmesh7.mgb", "r+b");
+            fseek(file, offsets[c], SEEK_SET);
+            fwrite(&saved, sizeof(int64_t), 1, file);
+            fclose(file);
+        }
+        Graph *B = read_graph_binary("jagmesh7.mgb");
+        assert(B != NULL);
+        B->~Graph();
+    }
+    G->~Graph();
+    remove("jagmesh7.mgb");
+
+    // Not a binary graph file
+    G = read_graph_binary("../Matrix/bcspwr01.mtx");
+    assert(G == NULL);
+
+    // Nonexistent binary graph file
+    G = read_graph_binary("../Tests/Matrix/no_such_file.mgb");
+    assert(G == NULL);
+
+#ifdef MONGOOSE_HAVE_ZLIB
+    // Gzip-compressed Matrix Market file matches the uncompressed one
+    G = read_graph("../Matrix/bcspwr01.mtx");
+    Graph *Z = read_graph("../Tests/Matrix/bcspwr01.mtx.gz");
+    if (!G || !Z)
+        return EXIT_FAILURE;
+    assert(Z->n == G->n && Z->nz == G->nz);
+    for (Int k = 0; k <= G->n; k++)
+        assert(Z->p[k] == G->p[k]);
+    for (Int k = 0; k < G->nz; k++)
+        assert(Z->i[k] == G->i[k]);
+    Z->~Graph();
+    G->~Graph();
+
+    // Compressed stream ends early
+    G = read_graph("../Tests/Matrix/truncated.mtx.gz");
+    assert(G == NULL);
+#endif
+
+    // METIS graph file matches the Matrix Market graph
+    G = read_graph("../Matrix/bcspwr01.mtx");
+    Graph *H = read_graph_metis("../Tests/Matrix/bcspwr01.graph");
+    if (!G || !H)
+        return EXIT_FAILURE;
+    assert(H->n == G->n && H->nz == G->nz);
+    assert(H->x == NULL && H->w == NULL);
+    for (Int k = 0; k <= G->n; k++)
+        assert(H->p[k] == G->p[k]);
+    for (Int k = 0; k < G->nz; k++)
+        assert(H->i[k] == G->i[k]);
+    H->~Graph();
+
+    // Binary edge list round trip, each edge listed once
+    FILE *file = fopen("bcspwr01.bel", "wb");
+    if (!file)
+        return EXIT_FAILURE;
+    for (Int j = 0; j < G->n; j++)
+    {
+        for (Int p = G->p[j]; p < G->p[j + 1]; p++)
+        {
+            Int i = G->i[p];
+            if (i < j)
+            {
+                fwrite(&i, sizeof(Int), 1, file);
+                fwrite(&j, sizeof(Int), 1, file);
+            }
+        }
+    }
+    fclose(file);
+    H = read_graph_edgelist("bcspwr01.bel", sizeof(Int), false);
+    if (!H)
+        return EXIT_FAILURE;
+    assert(H->n == G->n && H->nz == G->nz);
+    for (Int k = 0; k <= G->n; k++)
+        assert(H->p[k] == G->p[k]);
+    for (Int k = 0; k < G->nz; k++)
+        assert(H->i[k] == G->i[k]);
+    H->~Graph();
+    G->~Graph();
+
+    // Wrong record size or index width
+    G = read_graph_edgelist("bcspwr01.bel", sizeof(Int), true);
+    assert(G == NULL);
+    G = read_graph_edgelist("bcspwr01.bel", 2, false);
+    assert(G == NULL);
+    remove("bcspwr01.bel");
+
+    // METIS graph file with comments, edge weights and vertex weights
+    G = read_graph_metis("../Tests/Matrix/weighted.graph");
+    if (!G || !G->x || !G->w)
+        return EXIT_FAILURE;
+    assert(G->n == 4 && G->nz == 8);
+    assert(G->w[0] == 2 && G->w[1] == 3 && G->w[2] == 1 && G->w[3] == 7);
+
+    // Weighted edge list with 32-bit indices gives the same graph
+    file = fopen("weighted.bel", "wb");
+    if (!file)
+        return EXIT_FAILURE;
+    for (int32_t j = 0; j < G->n; j++)
+    {
+        for (Int p = G->p[j]; p < G->p[j + 1]; p++)
+        {
+            int32_t i = static_cast<int32_t>(G->i[p]);
+            if (i < j)
+            {
+                fwrite(&i, sizeof(int32_t), 1, file);
+                fwrite(&j, sizeof(int32_t), 1, file);
+                fwrite(&G->x[p], sizeof(double), 1, file);
+            }
+        }
+    }
+    fclose(file);
+    H = read_graph_edgelist("weighted.bel", sizeof(int32_t), true);
+    if (!H || !H->x)
+        return EXIT_FAILURE;
+    assert(H->n == G->n && H->nz == G->nz);
+    for (Int k = 0; k <= G->n; k++)
+        assert(H->p[k] == G->p[k]);
+    for (Int k = 0; k < G->nz; k++)
+    {
+        assert(H->i[k] == G->i[k]);
+        assert(H->x[k] == G->x[k]);
+    }
+    H->~Graph();
+    G->~Graph();
+    remove("weighted.bel");
+
+    // Header disagrees with the adjacency lists
+    G = read_graph_metis("../Tests/Matrix/bad_edge_count.graph");
+    assert(G == NULL);
+
+    // Nonexistent METIS graph file
+    G = read_graph_metis("../Tests/Matrix/no_such_file.graph");
+    assert(G == NULL);
+
+    // Partition output in text, binary and permutation formats
+    G = read_graph("../Matrix/bcspwr01.mtx");
+    if (!G)
+        return EXIT_FAILURE;
+    EdgeCut *cut = edge_cut(G);
+    if (!cut)
+        return EXIT_FAILURE;
+    bool written = write_partition(cut, "bcspwr01.part")
+                   && write_partition(cut, "bcspwr01.bin",
+                                      PartitionFormat_Binary)
+                   && write_partition(cut, "bcspwr01.perm",
+                                      PartitionFormat_Permutation);
+    if (!written)
+        return EXIT_FAILURE;
+
+    file = fopen("bcspwr01.part", "r");
+    for (Int k = 0; file && k < cut->n; k++)
+    {
+        long vertex, part;
+        int got = fscanf(file, "%ld %ld", &vertex, &part);
+        assert(got == 2 && vertex == k && part == cut->partition[k]);
+        (void)got; // Unused variable if NDEBUG
+    }
+    if (file)
+        fclose(file);
+
+    unsigned char bytes[32 + 8];
+    file = fopen("bcspwr01.bin", "rb");
+    if (!file || fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes))
+        return EXIT_FAILURE;
+    fclose(file);
+    assert(memcmp(bytes, "MONGPART", 8) == 0);
+    for (Int k = 0; k < cut->n; k++)
+        assert(((bytes[32 + k / 8] >> (k % 8)) & 1) == cut->partition[k]);
+
+    file = fopen("bcspwr01.perm", "r");
+    for (Int k = 0, part = 0; file && k < cut->n; k++)
+    {
+        long vertex;
+        int got = fscanf(file, "%ld", &vertex);
+        assert(got == 1 && vertex >= 0 && vertex < cut->n);
+        assert(cut->partition[vertex] >= part);
+        part = cut->partition[vertex];
+        (void)got;  // Unused variable if NDEBUG
+        (void)part; // Unused variable if NDEBUG
+    }
+    if (file)
+        fclose(file);
+
+    // Saved coarsening hierarchy gives the same cut as coarsening again
+    EdgeCut_Options *options = EdgeCut_Options::create();
+    Graph *J = read_graph("../Matrix/jagmesh7.mtx");
+    if (!options || !J)
+        return EXIT_FAILURE;
+    EdgeCut *direct = edge_cut(J, options);
+    written = write_hierarchy(J, options, "jagmesh7.mgh");
+    EdgeCut *reloaded = edge_cut_hierarchy("jagmesh7.mgh", options);
+    if (!direct || !written || !reloaded)
+        return EXIT_FAILURE;
+    assert(reloaded->n == direct->n);
+    assert(reloaded->cut_cost == direct->cut_cost);
+    for (Int k = 0; k < direct->n; k++)
+        assert(reloaded->partition[k] == direct->partition[k]);
+    direct->~EdgeCut();
+    reloaded->~EdgeCut();
+
+    // Corrupt hierarchy files: a column pointer out of order, a row index,
+    // a match, a coarse vertex and a fine vertex out of range in the finest
+    // level. The 32-byte header is followed by 72 bytes per level holding
+    // n, nz, cn and flags at bytes 0, 8, 16 and 24 and the offset of its
+    // arrays at byte 64: p, i, edge and vertex weights if flagged, gains,
+    // matching, matchmap and invmatchmap, each padded to 8 bytes.
+    {
+        FILE *hierarchy = fopen("jagmesh7.mgh", "r+b");
+        assert(hierarchy != NULL);
+        int64_t level[9];
+        fseek(hierarchy, 32, SEEK_SET);
+        size_t count = fread(level, sizeof(int64_t), 9, hierarchy);
+        assert(count == 9);
+        fclose(hierarchy);
+
+        int64_t n = level[0], nz = level[1], cn = level[2];
+        int64_t flags = level[3] & 0xffffffff;
+        int64_t p = level[8];
+        int64_t i = p + 8 * (n + 1);
+        int64_t gains = i + 8 * nz * ((flags & 1) ? 2 : 1)
+                        + ((flags & 2) ? 8 * n : 0);
+        int64_t matching = gains + 8 * n;
+        long offsets[5] = { long(p + 8), long(i), long(matching),
+                            long(matching + 8 * n),
+                            long(matching + 16 * n) };
+        int64_t values[5] = { nz + 1, n, n + 1, cn, n };
+        for (int c = 0; c < 5; c++)
+        {
+            hierarchy = fopen("jagmesh7.mgh", "r+b");
+            int64_t saved;
+            fseek(hierarchy, offsets[c], SEEK_SET);
+            count = fread(&saved, sizeof(int64_t), 1, hierarchy);
+            assert(count == 1);
+            (void)count; // Unused variable if NDEBUG
+            fseek(hierarchy, offsets[c], SEEK_SET);
+            fwrite(&values[c], sizeof(int64_t), 1, hierarchy);
+            fclose(hierarchy);
+
+            reloaded = edge_cut_hierarchy("jagmesh7.mgh", options);
+            assert(reloaded == NULL);
+
+            hierarchy = fopen("jagmesh7.mgh", "r+b");
+            fseek(hierarchy, offsets[c], SEEK_SET);
+            fwrite(&saved, sizeof(int64_t), 1, hierarchy);
+            fclose(hierarchy);
+        }
+        reloaded = edge_cut_hierarchy("jagmesh7.mgh", options);
+        assert(reloaded != NULL);
+        reloaded->~EdgeCut();
+    }
+    J->~Graph();
+    remove("jagmesh7.mgh");
+
+    // Not a hierarchy file
+    reloaded = edge_cut_hierarchy("../Matrix/bcspwr01.mtx", options);
+    assert(reloaded == NULL);
+    options->~EdgeCut_Options();
+
+    remove("bcspwr01.part");
+    remove("bcspwr01.bin");
+    remove("bcspwr01.perm");
+    cut->~EdgeCut();
+    G->~Graph();
+
     SuiteSparse_finish();
 
     return 0;